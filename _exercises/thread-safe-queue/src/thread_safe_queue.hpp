@@ -1,57 +1,323 @@
 #ifndef THREAD_SAFE_QUEUE_HPP
 #define THREAD_SAFE_QUEUE_HPP
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <iterator>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+// what push() does when a bounded queue is full
+enum class OverflowPolicy
+{
+    block,       // waits until a consumer makes room
+    fail,        // throws QueueFullError
+    caller_runs, // push() waits like block - try_push() lets the producer run the item itself
+    drop_oldest  // discards the item at the front of the queue
+};
+
+class QueueFullError : public std::runtime_error
+{
+public:
+    QueueFullError()
+        : std::runtime_error {"Queue is full"}
+    {
+    }
+};
+
+// unbounded by default; bounded when constructed with a capacity
+//  - high_water_mark() - the largest size the queue has reached
+//  - dropped_count() - items discarded by OverflowPolicy::drop_oldest
+//  - force_push() items do not count against the capacity and are never dropped
+//  - close() wakes every waiting consumer - pop() returns false once the queue is
+//    closed and drained; items pushed after close() are still handed out
 template <typename T>
 class ThreadSafeQueue
 {
     mutable std::mutex mtx_;
     std::condition_variable cv_not_empty_;
-    std::queue<T> queue_;
+    std::condition_variable cv_not_full_;
+
+    struct Entry
+    {
+        T item;
+        bool forced;
+    };
+
+    std::deque<Entry> queue_;
+    size_t bounded_size_ = 0; // items that count against the capacity
+    size_t waiters_ = 0;
+    size_t full_waiters_ = 0;
+    size_t capacity_ = 0; // 0 - unbounded
+    OverflowPolicy policy_ = OverflowPolicy::block;
+    size_t high_water_mark_ = 0;
+    size_t dropped_count_ = 0;
+    bool closed_ = false;
+
+    bool is_full() const
+    {
+        return capacity_ != 0 && bounded_size_ >= capacity_;
+    }
+
+    // makes room for one item as the policy says - the dropped item (if any) is returned
+    // so that it is destroyed outside the lock
+    std::optional<T> make_room(std::unique_lock<std::mutex>& lk)
+    {
+        if (!is_full())
+            return std::nullopt;
+
+        switch (policy_)
+        {
+        case OverflowPolicy::fail:
+            throw QueueFullError {};
+        case OverflowPolicy::drop_oldest:
+        {
+            // the oldest item that was not forced - a full queue always has one
+            auto oldest = std::find_if(queue_.begin(), queue_.end(), [](const Entry& e) { return !e.forced; });
+            std::optional<T> dropped {std::move(oldest->item)};
+            queue_.erase(oldest);
+            --bounded_size_;
+            ++dropped_count_;
+            return dropped;
+        }
+        default: // block, caller_runs
+            ++full_waiters_;
+            cv_not_full_.wait(lk, [this] { return !is_full() || closed_; }); // consumers may be gone after close()
+            --full_waiters_;
+            return std::nullopt;
+        }
+    }
+
+    template <typename U>
+    void enqueue(U&& item, bool forced = false)
+    {
+        queue_.push_back(Entry {std::forward<U>(item), forced});
+        if (!forced)
+            ++bounded_size_;
+        high_water_mark_ = std::max(high_water_mark_, queue_.size());
+    }
+
+    void dequeue(T& item)
+    {
+        if constexpr (std::is_nothrow_move_assignable_v<T>)
+            item = std::move(queue_.front().item);
+        else
+            item = queue_.front().item;
+
+        if (!queue_.front().forced)
+            --bounded_size_;
+        queue_.pop_front();
+
+        if (full_waiters_ != 0)
+            cv_not_full_.notify_one();
+    }
+
+    // wakes at most as many waiting consumers as there are new items
+    void notify(size_t count)
+    {
+        if (count >= waiters_)
+            cv_not_empty_.notify_all();
+        else
+            while (count--)
+                cv_not_empty_.notify_one();
+    }
 
 public:
     ThreadSafeQueue() = default;
+
+    ThreadSafeQueue(size_t capacity, OverflowPolicy policy)
+        : capacity_ {capacity}
+        , policy_ {policy}
+    {
+        if (capacity_ == 0)
+            throw std::invalid_argument("Capacity must be positive");
+    }
+
     ThreadSafeQueue(const ThreadSafeQueue&) = delete;
     ThreadSafeQueue& operator=(const ThreadSafeQueue&) = delete;
 
+    // O(1) - a single notify_all, no matter how many consumers wait
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+        }
+
+        cv_not_empty_.notify_all();
+        cv_not_full_.notify_all();
+    }
+
+    // removes every item under a single lock - O(1), the items are destroyed by the caller
+    std::queue<T> take_all()
+    {
+        std::deque<Entry> entries;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            entries.swap(queue_);
+            bounded_size_ = 0;
+        }
+
+        cv_not_full_.notify_all();
+
+        std::queue<T> items;
+        for (Entry& e : entries)
+            items.push(std::move(e.item));
+        return items;
+    }
+
+    bool closed() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return closed_;
+    }
+
     bool empty() const
     {
         std::lock_guard<std::mutex> lock(mtx_);
         return queue_.empty();
     }
 
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return queue_.size();
+    }
+
+    // 0 - unbounded
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    OverflowPolicy overflow_policy() const
+    {
+        return policy_;
+    }
+
+    size_t high_water_mark() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return high_water_mark_;
+    }
+
+    size_t dropped_count() const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return dropped_count_;
+    }
+
     void push(const T& item)
     {
+        push(T(item));
+    }
+
+    void push(T&& item)
+    {
+        std::optional<T> dropped;
+
         {
             std::unique_lock<std::mutex> lock(mtx_);
-            queue_.push(item);
+            dropped = make_room(lock);
+            enqueue(std::move(item));
         }
 
         cv_not_empty_.notify_one();
     }
 
-    void push(T&& item)
+    void push(std::initializer_list<T> lst)
+    {
+        std::vector<T> items(lst);
+        push_range(items.begin(), items.end());
+    }
+
+    // moves [first, last) into the queue under a single lock
+    //  - a bounded queue may release the lock while waiting for room (block, caller_runs)
+    //  - fail throws before anything is pushed if the whole range does not fit; with input
+    //    iterators it throws when the queue fills up and the items pushed so far remain
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        std::vector<T> dropped;
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            if (capacity_ != 0 && policy_ == OverflowPolicy::fail && bounded_size_ + static_cast<size_t>(std::distance(first, last)) > capacity_)
+                throw QueueFullError {};
+        }
+
+        size_t count = 0;
+        try
+        {
+            for (; first != last; ++first, ++count)
+            {
+                if (is_full())
+                {
+                    notify(count); // consumers make room meanwhile
+                    count = 0;
+
+                    if (std::optional<T> item = make_room(lock))
+                        dropped.push_back(std::move(*item));
+                }
+
+                enqueue(std::move(*first));
+            }
+        }
+        catch (...)
+        {
+            notify(count); // fail with an input range - the items pushed so far stay queued
+            throw;
+        }
+
+        notify(count);
+    }
+
+    // ignores the capacity - for control items (e.g. stop tasks) that must not block, be refused or be dropped
+    void force_push(T&& item)
     {
         {
             std::unique_lock<std::mutex> lock(mtx_);
-            queue_.push(std::move(item));
+            enqueue(std::move(item), true);
         }
 
         cv_not_empty_.notify_one();
     }
 
-    void push(std::initializer_list<T> lst)
+    // false if the queue is full - item is left untouched
+    bool try_push(T&& item)
     {
         {
             std::unique_lock<std::mutex> lock(mtx_);
-            for (const auto& item : lst)
-                queue_.push(item);
+            if (is_full())
+                return false;
+            enqueue(std::move(item));
         }
 
-        cv_not_empty_.notify_all();
+        cv_not_empty_.notify_one();
+        return true;
+    }
+
+    // pushes the longest prefix of [first, last) that fits under a single lock - returns its end
+    template <typename InputIt>
+    InputIt try_push_range(InputIt first, InputIt last)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+
+        size_t count = 0;
+        for (; first != last && !is_full(); ++first, ++count)
+            enqueue(std::move(*first));
+
+        notify(count);
+        return first;
     }
 
     bool try_pop(T& item)
@@ -59,28 +325,41 @@ public:
         std::unique_lock<std::mutex> lk {mtx_, std::try_to_lock};
         if (lk.owns_lock() && !queue_.empty())
         {
-            if constexpr (std::is_nothrow_move_assignable_v<T>)
-                item = std::move(queue_.front());
-            else
-                item = queue_.front();
-                
-            queue_.pop();
+            dequeue(item);
             return true;
         }
         return false;
     }
 
-    void pop(T& item)
+    // returns false if the queue is closed and empty
+    bool pop(T& item)
     {
         std::unique_lock<std::mutex> lk {mtx_};
-        cv_not_empty_.wait(lk, [this] { return !queue_.empty(); });
-        
-        if constexpr (std::is_nothrow_move_assignable_v<T>)
-            item = std::move(queue_.front());
-        else
-            item = queue_.front();
-        
-        queue_.pop();
+        ++waiters_;
+        cv_not_empty_.wait(lk, [this] { return !queue_.empty() || closed_; });
+        --waiters_;
+
+        if (queue_.empty())
+            return false;
+
+        dequeue(item);
+        return true;
+    }
+
+    // returns false if no item arrived within timeout or the queue is closed and empty
+    template <typename Rep, typename Period>
+    bool pop_for(T& item, std::chrono::duration<Rep, Period> timeout)
+    {
+        std::unique_lock<std::mutex> lk {mtx_};
+        ++waiters_;
+        cv_not_empty_.wait_for(lk, timeout, [this] { return !queue_.empty() || closed_; });
+        --waiters_;
+
+        if (queue_.empty())
+            return false;
+
+        dequeue(item);
+        return true;
     }
 };
 
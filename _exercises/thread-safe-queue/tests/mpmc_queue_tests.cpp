@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "mpmc_queue.hpp"
+
+using namespace std;
+
+TEST_CASE("BoundedMpmcQueue")
+{
+    BoundedMpmcQueue<int> q(4);
+
+    SECTION("is empty after creation")
+    {
+        REQUIRE(q.empty() == true);
+    }
+
+    SECTION("capacity is rounded up to power of 2")
+    {
+        BoundedMpmcQueue<int> q5(5);
+
+        REQUIRE(q5.capacity() == 8);
+    }
+
+    SECTION("is not empty after push")
+    {
+        q.push(1);
+
+        REQUIRE(q.empty() == false);
+    }
+
+    SECTION("pops items in FIFO order")
+    {
+        q.push(1);
+        q.push(2);
+
+        int item;
+        auto result = q.try_pop(item);
+
+        REQUIRE(result);
+        REQUIRE(item == 1);
+    }
+
+    SECTION("try_pop returns false when last item removed")
+    {
+        q.push(1);
+
+        int item;
+        q.try_pop(item);
+        auto result = q.try_pop(item);
+
+        REQUIRE(result == false);
+        REQUIRE(q.empty() == true);
+    }
+
+    SECTION("try_push returns false when queue is full")
+    {
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(q.try_push(i));
+
+        REQUIRE(q.try_push(4) == false);
+
+        int item;
+        q.try_pop(item);
+        REQUIRE(q.try_push(4));
+    }
+
+    SECTION("try_push_range pushes the prefix that fits")
+    {
+        vector<int> items = {1, 2, 3, 4, 5, 6};
+
+        auto end = q.try_push_range(items.begin(), items.end());
+
+        REQUIRE(end == items.begin() + 4);
+
+        int item;
+        q.try_pop(item);
+        REQUIRE(item == 1);
+        REQUIRE(q.try_push_range(end, items.end()) == end + 1);
+    }
+
+    SECTION("client waits when poping from empty")
+    {
+        int item;
+
+        chrono::high_resolution_clock::time_point t1;
+
+        thread thd{[&q, &item, &t1] {
+            q.pop(item);
+            t1 = chrono::high_resolution_clock::now();
+        }};
+
+        this_thread::sleep_for(200ms);
+        chrono::high_resolution_clock::time_point t2 = chrono::high_resolution_clock::now();
+        q.push(1);
+        thd.join();
+        REQUIRE(t1 >= t2);
+        REQUIRE(item == 1);
+    }
+
+    SECTION("when client push many items all waiting threads are notified")
+    {
+        const int size = 3;
+
+        vector<int> items(size);
+        vector<thread> threads(size);
+
+        for (int i = 0; i < size; ++i)
+        {
+            threads[i] = thread{[&q, i, &items] { q.pop(items[i]); }};
+        }
+
+        q.push({1, 2, 3});
+
+        for (auto& thd : threads)
+            thd.join();
+
+        REQUIRE(none_of(items.begin(), items.end(), [](int x) { return x == 0; }));
+    }
+
+    SECTION("many producers & consumers transfer every item exactly once")
+    {
+        const int producers = 4;
+        const int items_per_producer = 10'000;
+
+        vector<long> sums(producers);
+        vector<thread> threads;
+
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&q] {
+                for (int i = 1; i <= items_per_producer; ++i)
+                    q.push(i);
+            });
+
+        for (int c = 0; c < producers; ++c)
+            threads.emplace_back([&q, &sums, c] {
+                for (int i = 0; i < items_per_producer; ++i)
+                {
+                    int item;
+                    q.pop(item);
+                    sums[c] += item;
+                }
+            });
+
+        for (auto& thd : threads)
+            thd.join();
+
+        const long expected = producers * (long(items_per_producer) * (items_per_producer + 1) / 2);
+        REQUIRE(accumulate(sums.begin(), sums.end(), 0L) == expected);
+        REQUIRE(q.empty());
+    }
+
+    SECTION("destroys items left in the queue")
+    {
+        auto item = make_shared<int>(42);
+
+        {
+            BoundedMpmcQueue<shared_ptr<int>> q_ptr(2);
+            q_ptr.push(item);
+            REQUIRE(item.use_count() == 2);
+        }
+
+        REQUIRE(item.use_count() == 1);
+    }
+}
@@ -1,7 +1,12 @@
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <iterator>
 #include <queue>
+#include <sstream>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "catch.hpp"
 
@@ -88,3 +93,263 @@ TEST_CASE("ThreadSafeQueue")
         REQUIRE(none_of(items.begin(), items.end(), [](int x) { return x == 0; }));
     }
 }
+
+TEST_CASE("ThreadSafeQueue - bounded")
+{
+    SECTION("capacity must be positive")
+    {
+        REQUIRE_THROWS_AS((ThreadSafeQueue<int>{0, OverflowPolicy::block}), invalid_argument);
+    }
+
+    SECTION("unbounded queue reports capacity 0")
+    {
+        ThreadSafeQueue<int> tsq;
+
+        REQUIRE(tsq.capacity() == 0);
+    }
+
+    SECTION("block - push waits until a consumer makes room")
+    {
+        ThreadSafeQueue<int> tsq{2, OverflowPolicy::block};
+        tsq.push(1);
+        tsq.push(2);
+
+        atomic<bool> pushed{false};
+        thread producer{[&tsq, &pushed] {
+            tsq.push(3);
+            pushed = true;
+        }};
+
+        this_thread::sleep_for(100ms);
+        REQUIRE(pushed == false);
+
+        int item;
+        tsq.pop(item);
+        producer.join();
+
+        REQUIRE(pushed == true);
+        REQUIRE(item == 1);
+        REQUIRE(tsq.size() == 2);
+    }
+
+    SECTION("fail - push throws QueueFullError and leaves the queue untouched")
+    {
+        ThreadSafeQueue<int> tsq{2, OverflowPolicy::fail};
+        tsq.push(1);
+        tsq.push(2);
+
+        REQUIRE_THROWS_AS(tsq.push(3), QueueFullError);
+        REQUIRE(tsq.size() == 2);
+
+        int item;
+        tsq.pop(item);
+        REQUIRE(item == 1);
+        tsq.pop(item);
+        REQUIRE(item == 2);
+    }
+
+    SECTION("caller_runs - try_push returns false when full, push waits like block")
+    {
+        ThreadSafeQueue<int> tsq{1, OverflowPolicy::caller_runs};
+        REQUIRE(tsq.try_push(1));
+
+        int rejected = 2;
+        REQUIRE(tsq.try_push(move(rejected)) == false);
+        REQUIRE(rejected == 2);
+
+        thread producer{[&tsq] { tsq.push(3); }};
+
+        int item;
+        tsq.pop(item);
+        producer.join();
+
+        REQUIRE(item == 1);
+        tsq.pop(item);
+        REQUIRE(item == 3);
+    }
+
+    SECTION("drop_oldest - push discards the front item and counts it")
+    {
+        ThreadSafeQueue<int> tsq{2, OverflowPolicy::drop_oldest};
+        tsq.push({1, 2, 3, 4});
+
+        REQUIRE(tsq.size() == 2);
+        REQUIRE(tsq.dropped_count() == 2);
+
+        int item;
+        tsq.pop(item);
+        REQUIRE(item == 3);
+        tsq.pop(item);
+        REQUIRE(item == 4);
+    }
+
+    SECTION("high_water_mark is the largest size reached")
+    {
+        ThreadSafeQueue<int> tsq{4, OverflowPolicy::drop_oldest};
+        REQUIRE(tsq.high_water_mark() == 0);
+
+        tsq.push({1, 2, 3});
+        int item;
+        tsq.pop(item);
+        tsq.pop(item);
+        tsq.push(4);
+
+        REQUIRE(tsq.size() == 2);
+        REQUIRE(tsq.high_water_mark() == 3);
+
+        tsq.push({5, 6, 7, 8});
+        REQUIRE(tsq.high_water_mark() == 4);
+        REQUIRE(tsq.dropped_count() == 2);
+    }
+
+    SECTION("push_range under fail pushes nothing if the range does not fit")
+    {
+        ThreadSafeQueue<int> tsq{3, OverflowPolicy::fail};
+        tsq.push(1);
+
+        vector<int> items = {2, 3, 4};
+        REQUIRE_THROWS_AS(tsq.push_range(items.begin(), items.end()), QueueFullError);
+        REQUIRE(tsq.size() == 1);
+
+        tsq.push_range(items.begin(), items.begin() + 2);
+        REQUIRE(tsq.size() == 3);
+    }
+
+    SECTION("push_range under fail with input iterators keeps and hands out the items that fit")
+    {
+        ThreadSafeQueue<int> tsq{2, OverflowPolicy::fail};
+
+        int item = 0;
+        thread consumer{[&tsq, &item] { tsq.pop(item); }};
+        this_thread::sleep_for(100ms);
+
+        istringstream input{"1 2 3"};
+        REQUIRE_THROWS_AS(tsq.push_range(istream_iterator<int>{input}, istream_iterator<int>{}), QueueFullError);
+
+        consumer.join();
+        REQUIRE(item == 1);
+        REQUIRE(tsq.size() == 1);
+    }
+
+    SECTION("try_push_range pushes the prefix that fits")
+    {
+        ThreadSafeQueue<int> tsq{3, OverflowPolicy::fail};
+        vector<int> items = {1, 2, 3, 4, 5};
+
+        auto end = tsq.try_push_range(items.begin(), items.end());
+
+        REQUIRE(end == items.begin() + 3);
+        REQUIRE(tsq.size() == 3);
+    }
+
+    SECTION("force_push ignores the capacity")
+    {
+        ThreadSafeQueue<int> tsq{1, OverflowPolicy::fail};
+        tsq.push(1);
+        tsq.force_push(2);
+
+        REQUIRE(tsq.size() == 2);
+        REQUIRE(tsq.high_water_mark() == 2);
+    }
+
+    SECTION("drop_oldest - forced items are never dropped nor count against the capacity")
+    {
+        ThreadSafeQueue<int> tsq{2, OverflowPolicy::drop_oldest};
+        tsq.force_push(1);
+        tsq.push(2);
+        tsq.force_push(3);
+        tsq.push(4);
+        tsq.push(5);
+
+        REQUIRE(tsq.size() == 4);
+        REQUIRE(tsq.dropped_count() == 1);
+
+        vector<int> items(4);
+        for (int& item : items)
+            tsq.pop(item);
+
+        REQUIRE(items == vector<int>{1, 3, 4, 5});
+    }
+}
+
+TEST_CASE("ThreadSafeQueue - close")
+{
+    ThreadSafeQueue<int> tsq;
+
+    SECTION("is open after creation")
+    {
+        REQUIRE(tsq.closed() == false);
+    }
+
+    SECTION("close wakes all waiting consumers - pop returns false")
+    {
+        const int size = 3;
+
+        vector<thread> threads;
+        atomic<int> results_false{0};
+
+        for (int i = 0; i < size; ++i)
+            threads.emplace_back([&tsq, &results_false] {
+                int item;
+                if (!tsq.pop(item))
+                    ++results_false;
+            });
+
+        this_thread::sleep_for(100ms);
+        tsq.close();
+
+        for (auto& thd : threads)
+            thd.join();
+
+        REQUIRE(tsq.closed());
+        REQUIRE(results_false == size);
+    }
+
+    SECTION("pop hands out queued items and returns false once drained")
+    {
+        tsq.push({1, 2});
+        tsq.close();
+
+        int item;
+        REQUIRE(tsq.pop(item));
+        REQUIRE(item == 1);
+        REQUIRE(tsq.pop(item));
+        REQUIRE(item == 2);
+        REQUIRE(tsq.pop(item) == false);
+    }
+
+    SECTION("pop_for returns false on a closed empty queue without waiting")
+    {
+        tsq.close();
+
+        int item;
+        auto start = chrono::steady_clock::now();
+        REQUIRE(tsq.pop_for(item, 10s) == false);
+        REQUIRE(chrono::steady_clock::now() - start < 5s);
+    }
+
+    SECTION("close wakes a producer blocked on a full queue")
+    {
+        ThreadSafeQueue<int> bounded{1, OverflowPolicy::block};
+        bounded.push(1);
+
+        thread producer{[&bounded] { bounded.push(2); }};
+
+        this_thread::sleep_for(100ms);
+        bounded.close();
+        producer.join();
+
+        REQUIRE(bounded.size() == 2);
+    }
+
+    SECTION("take_all removes every item at once")
+    {
+        tsq.push({1, 2, 3});
+
+        auto items = tsq.take_all();
+
+        REQUIRE(items.size() == 3);
+        REQUIRE(items.front() == 1);
+        REQUIRE(tsq.empty());
+    }
+}
@@ -0,0 +1,86 @@
+#include "counting_new.hpp"
+#include "thread_pool.hpp"
+
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// usage: allocation_bench [task_count]
+
+int calculate(int x)
+{
+    return x * x;
+}
+
+// submit as it was done before ext::unique_function: std::function requires a copyable callable
+template <typename F>
+auto legacy_submit(ThreadSafeQueue<std::function<void()>>& queue, F&& f) -> std::future<decltype(f())>
+{
+    using ResultT = decltype(f());
+    auto pt = std::make_shared<std::packaged_task<ResultT()>>(std::forward<F>(f));
+    std::future<ResultT> f_result = pt->get_future();
+    queue.push([pt] { (*pt)(); });
+    return f_result;
+}
+
+template <typename F>
+auto task_submit(ThreadSafeQueue<Task>& queue, F&& f) -> std::future<decltype(f())>
+{
+    using ResultT = decltype(f());
+    std::packaged_task<ResultT()> pt(std::forward<F>(f));
+    std::future<ResultT> f_result = pt.get_future();
+    queue.push(Task {std::move(pt)});
+    return f_result;
+}
+
+template <typename TTask, typename TSubmit>
+double allocations_per_task(size_t task_count, TSubmit submit)
+{
+    ThreadSafeQueue<TTask> queue;
+    std::vector<std::future<int>> results;
+    results.reserve(task_count);
+
+    const size_t before = allocation_count();
+
+    for (size_t i = 0; i < task_count; ++i)
+        results.push_back(submit(queue, [i] { return calculate(static_cast<int>(i)); }));
+
+    TTask task; // drains queue on the same thread
+    while (queue.try_pop(task))
+        task();
+
+    const size_t after = allocation_count();
+    return static_cast<double>(after - before) / task_count;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t task_count = argc > 1 ? std::stoul(argv[1]) : 100'000;
+
+    const double legacy = allocations_per_task<std::function<void()>>(task_count,
+        [](auto& q, auto&& f) { return legacy_submit(q, std::move(f)); });
+    const double unique = allocations_per_task<Task>(task_count,
+        [](auto& q, auto&& f) { return task_submit(q, std::move(f)); });
+
+    size_t pool_allocations = 0;
+    {
+        ver_2_0::ThreadPool pool(2);
+        std::vector<ver_2_0::Future<int>> results;
+        results.reserve(task_count);
+
+        const size_t before = allocation_count();
+        for (size_t i = 0; i < task_count; ++i)
+            results.push_back(pool.submit([i] { return calculate(static_cast<int>(i)); }));
+        for (auto& r : results)
+            r.get();
+        pool_allocations = allocation_count() - before;
+    }
+
+    std::cout << "variant,allocations_per_task\n";
+    std::cout << "shared_ptr+std::function," << legacy << "\n";
+    std::cout << "unique_function," << unique << "\n";
+    std::cout << "ver_2_0::ThreadPool::submit," << static_cast<double>(pool_allocations) / task_count << "\n";
+}
@@ -0,0 +1,68 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// usage: bulk_submit_bench [batch_size] [batch_count] [thread_count]
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct BatchTimes
+{
+    double enqueue_us = 0;
+    double completion_us = 0;
+};
+
+template <typename TSubmitBatch>
+BatchTimes run_batches(ver_2_0::ThreadPool& pool, size_t batch_size, size_t batch_count, TSubmitBatch submit_batch)
+{
+    BatchTimes times;
+
+    for (size_t b = 0; b < batch_count; ++b)
+    {
+        const auto start = Clock::now();
+        std::vector<ver_2_0::Future<size_t>> results = submit_batch(pool, batch_size);
+        const auto enqueued = Clock::now();
+
+        for (auto& r : results)
+            r.get();
+        const auto end = Clock::now();
+
+        times.enqueue_us += std::chrono::duration<double, std::micro>(enqueued - start).count();
+        times.completion_us += std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    times.enqueue_us /= batch_count;
+    times.completion_us /= batch_count;
+
+    return times;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t batch_size = argc > 1 ? std::stoul(argv[1]) : 10'000;
+    const size_t batch_count = argc > 2 ? std::stoul(argv[2]) : 50;
+    const size_t thread_count = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    const auto single = run_batches(pool, batch_size, batch_count, [](ver_2_0::ThreadPool& pool, size_t count) {
+        std::vector<ver_2_0::Future<size_t>> results;
+        results.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            results.push_back(pool.submit([i] { return i; }));
+        return results;
+    });
+
+    const auto bulk = run_batches(pool, batch_size, batch_count, [](ver_2_0::ThreadPool& pool, size_t count) {
+        return pool.submit_n(count, [](size_t i) { return i; });
+    });
+
+    std::cout << "variant,threads,batch_size,enqueue_us,completion_us\n";
+    std::cout << "submit," << thread_count << "," << batch_size << "," << single.enqueue_us << "," << single.completion_us << "\n";
+    std::cout << "submit_n," << thread_count << "," << batch_size << "," << bulk.enqueue_us << "," << bulk.completion_us << "\n";
+}
@@ -0,0 +1,65 @@
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// pipelines of dependent stages: blocking get() between stages vs chaining with then()
+// usage: continuation_bench [pipelines] [stages] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+double blocking_pipelines(ver_2_0::ThreadPool& pool, size_t pipelines, size_t stages)
+{
+    const auto start = Clock::now();
+
+    std::vector<ver_2_0::Future<size_t>> results;
+    results.reserve(pipelines);
+    for (size_t p = 0; p < pipelines; ++p)
+        results.push_back(pool.submit([p] { return p; }));
+
+    // every stage waits for the previous one in the submitting thread
+    for (size_t s = 1; s < stages; ++s)
+        for (auto& r : results)
+            r = pool.submit([value = r.get()] { return value + 1; });
+
+    for (auto& r : results)
+        r.get();
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double chained_pipelines(ver_2_0::ThreadPool& pool, size_t pipelines, size_t stages)
+{
+    const auto start = Clock::now();
+
+    std::vector<ver_2_0::Future<size_t>> results;
+    results.reserve(pipelines);
+    for (size_t p = 0; p < pipelines; ++p)
+    {
+        auto f = pool.submit([p] { return p; });
+        for (size_t s = 1; s < stages; ++s)
+            f = f.then([](size_t value) { return value + 1; });
+        results.push_back(std::move(f));
+    }
+
+    for (auto& r : results)
+        r.get();
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t pipelines = argc > 1 ? std::stoul(argv[1]) : 1'000;
+    const size_t stages = argc > 2 ? std::stoul(argv[2]) : 16;
+    const size_t thread_count = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    std::cout << "mode,threads,pipelines,stages,total_ms\n";
+    std::cout << "blocking_get," << thread_count << "," << pipelines << "," << stages << "," << blocking_pipelines(pool, pipelines, stages) << "\n";
+    std::cout << "then," << thread_count << "," << pipelines << "," << stages << "," << chained_pipelines(pool, pipelines, stages) << "\n";
+}
@@ -0,0 +1,161 @@
+#include "coro_task.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// many I/O-bound flows on a few workers: a worker blocked in sleep_for per I/O wait
+// vs. coroutines suspended on a future completed by a simulated I/O thread
+// usage: coroutine_bench [flows] [io_per_flow] [io_latency_us] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+// completes promises after a delay - stands in for an asynchronous I/O device
+class SimulatedIo
+{
+public:
+    explicit SimulatedIo(ver_2_0::Executor& executor)
+        : executor_ {executor}
+        , thd_ {[this] { run(); }}
+    {
+    }
+
+    ~SimulatedIo()
+    {
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thd_.join();
+    }
+
+    ver_2_0::Future<void> read(std::chrono::microseconds latency)
+    {
+        ver_2_0::Promise<void> promise(nullptr, &executor_);
+        auto f_done = promise.get_future();
+
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            requests_.push(Request {Clock::now() + latency, std::move(promise)});
+        }
+        cv_.notify_one();
+
+        return f_done;
+    }
+
+private:
+    struct Request
+    {
+        Clock::time_point due;
+        mutable ver_2_0::Promise<void> promise;
+
+        bool operator>(const Request& other) const
+        {
+            return due > other.due;
+        }
+    };
+
+    ver_2_0::Executor& executor_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::priority_queue<Request, std::vector<Request>, std::greater<>> requests_;
+    bool stop_ = false;
+    std::thread thd_;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk {mtx_};
+
+        while (!stop_)
+        {
+            if (requests_.empty())
+            {
+                cv_.wait(lk);
+                continue;
+            }
+
+            if (Clock::now() < requests_.top().due)
+            {
+                cv_.wait_until(lk, requests_.top().due);
+                continue;
+            }
+
+            ver_2_0::Promise<void> promise = std::move(requests_.top().promise);
+            requests_.pop();
+
+            lk.unlock();
+            promise.set_value();
+            lk.lock();
+        }
+    }
+};
+
+double blocking_flows_ms(size_t thread_count, size_t flows, size_t io_per_flow, std::chrono::microseconds latency)
+{
+    const auto start = Clock::now();
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+
+        std::vector<ver_2_0::Future<void>> results;
+        for (size_t i = 0; i < flows; ++i)
+            results.push_back(pool.submit([=] {
+                for (size_t io = 0; io < io_per_flow; ++io)
+                    std::this_thread::sleep_for(latency);
+            }));
+
+        for (auto& r : results)
+            r.get();
+    }
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+ver_2_0::CoroTask<size_t> flow(SimulatedIo& io, size_t io_per_flow, std::chrono::microseconds latency)
+{
+    size_t completed = 0;
+    for (size_t i = 0; i < io_per_flow; ++i)
+    {
+        co_await io.read(latency);
+        ++completed;
+    }
+    co_return completed;
+}
+
+double coroutine_flows_ms(size_t thread_count, size_t flows, size_t io_per_flow, std::chrono::microseconds latency)
+{
+    const auto start = Clock::now();
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+        SimulatedIo io {pool};
+
+        std::vector<ver_2_0::Future<size_t>> results;
+        for (size_t i = 0; i < flows; ++i)
+            results.push_back(ver_2_0::spawn(pool, flow(io, io_per_flow, latency)));
+
+        for (auto& r : results)
+            r.get();
+    }
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t flows = argc > 1 ? std::stoul(argv[1]) : 2'000;
+    const size_t io_per_flow = argc > 2 ? std::stoul(argv[2]) : 5;
+    const std::chrono::microseconds latency {argc > 3 ? std::stol(argv[3]) : 1'000};
+    const size_t thread_count = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "mode,threads,flows,io_per_flow,io_latency_us,total_ms\n";
+    std::cout << "blocking," << thread_count << "," << flows << "," << io_per_flow << "," << latency.count() << ","
+              << blocking_flows_ms(thread_count, flows, io_per_flow, latency) << "\n";
+    std::cout << "coroutines," << thread_count << "," << flows << "," << io_per_flow << "," << latency.count() << ","
+              << coroutine_flows_ms(thread_count, flows, io_per_flow, latency) << "\n";
+}
@@ -0,0 +1,12 @@
+#ifndef COUNTING_NEW_HPP
+#define COUNTING_NEW_HPP
+
+#include <cstddef>
+
+// allocations made by any form of operator new since the program started
+//  - the replacements live in counting_new.cpp: defined in the same translation unit
+//    as their callers they get inlined, and GCC then sees malloc()/free() paired with
+//    new/delete (-Wmismatched-new-delete)
+size_t allocation_count();
+
+#endif // COUNTING_NEW_HPP
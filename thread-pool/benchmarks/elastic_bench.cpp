@@ -0,0 +1,51 @@
+#include "elastic_thread_pool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// bursts of blocking tasks separated by idle periods - prints pool metrics after every phase
+// usage: elastic_bench [max_threads] [burst_size] [burst_count]
+
+void print_stats(const std::string& phase, const ver_2_0::ElasticPoolStats& stats)
+{
+    std::cout << phase << "," << stats.threads << "," << stats.idle_threads << "," << stats.peak_threads << ","
+              << stats.spawned_threads << "," << stats.retired_threads << "," << stats.queue_depth << ","
+              << stats.executed_tasks << "," << stats.avg_queue_delay.count() / 1000.0 << ","
+              << stats.max_queue_delay.count() / 1000.0 << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace std::literals;
+
+    const size_t max_threads = argc > 1 ? std::stoul(argv[1]) : 16;
+    const size_t burst_size = argc > 2 ? std::stoul(argv[2]) : 200;
+    const size_t burst_count = argc > 3 ? std::stoul(argv[3]) : 3;
+
+    ver_2_0::ElasticOptions options;
+    options.min_threads = 1;
+    options.max_threads = max_threads;
+    options.idle_timeout = 100ms;
+
+    ver_2_0::ElasticThreadPool pool(options);
+
+    std::cout << "phase,threads,idle_threads,peak_threads,spawned,retired,queue_depth,executed,avg_queue_delay_us,max_queue_delay_us\n";
+    print_stats("start", pool.stats());
+
+    for (size_t b = 0; b < burst_count; ++b)
+    {
+        std::vector<ver_2_0::Future<void>> results;
+        for (size_t i = 0; i < burst_size; ++i)
+            results.push_back(pool.submit([] { std::this_thread::sleep_for(2ms); }));
+
+        for (auto& r : results)
+            r.get();
+        print_stats("burst#" + std::to_string(b + 1), pool.stats());
+
+        std::this_thread::sleep_for(500ms);
+        print_stats("idle#" + std::to_string(b + 1), pool.stats());
+    }
+}
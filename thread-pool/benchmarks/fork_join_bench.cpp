@@ -0,0 +1,90 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// recursive fork-join on a fixed-size pool: tasks submit subtasks and get() their results
+// (safe only because a waiting worker runs queued tasks instead of blocking)
+// usage: fork_join_bench [N] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t sequential_cutoff = 10'000;
+
+void parallel_quicksort(ver_2_0::ThreadPool& pool, std::vector<int>::iterator first, std::vector<int>::iterator last)
+{
+    if (last - first <= static_cast<std::ptrdiff_t>(sequential_cutoff))
+    {
+        std::sort(first, last);
+        return;
+    }
+
+    const int pivot = *(first + (last - first) / 2);
+    auto middle_1 = std::partition(first, last, [pivot](int x) { return x < pivot; });
+    auto middle_2 = std::partition(middle_1, last, [pivot](int x) { return !(pivot < x); });
+
+    auto f_left = pool.submit([&pool, first, middle_1] { parallel_quicksort(pool, first, middle_1); });
+    parallel_quicksort(pool, middle_2, last);
+    f_left.get();
+}
+
+int64_t tree_sum(ver_2_0::ThreadPool& pool, const int* first, const int* last)
+{
+    if (static_cast<size_t>(last - first) <= sequential_cutoff)
+        return std::accumulate(first, last, int64_t {0});
+
+    const int* middle = first + (last - first) / 2;
+    auto f_left = pool.submit([&pool, first, middle] { return tree_sum(pool, first, middle); });
+    const int64_t right = tree_sum(pool, middle, last);
+    return f_left.get() + right;
+}
+
+template <typename F>
+double measure_ms(F f)
+{
+    const auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t N = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<int> data(N);
+    std::mt19937 rnd {42};
+    std::uniform_int_distribution<int> distr {0, 1'000'000};
+    std::generate(data.begin(), data.end(), [&] { return distr(rnd); });
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    std::cout << "algorithm,mode,threads,N,time_ms\n";
+
+    auto sorted = data;
+    std::cout << "quicksort,sequential,1," << N << "," << measure_ms([&] { std::sort(sorted.begin(), sorted.end()); }) << "\n";
+
+    auto fork_join_sorted = data;
+    std::cout << "quicksort,fork_join," << thread_count << "," << N << ","
+              << measure_ms([&] { pool.submit([&] { parallel_quicksort(pool, fork_join_sorted.begin(), fork_join_sorted.end()); }).get(); }) << "\n";
+
+    if (fork_join_sorted != sorted)
+        std::cerr << "quicksort: wrong result\n";
+
+    int64_t sum = 0;
+    std::cout << "tree_sum,sequential,1," << N << "," << measure_ms([&] { sum = std::accumulate(data.begin(), data.end(), int64_t {0}); }) << "\n";
+
+    int64_t fork_join_sum = 0;
+    std::cout << "tree_sum,fork_join," << thread_count << "," << N << ","
+              << measure_ms([&] { fork_join_sum = pool.submit([&] { return tree_sum(pool, data.data(), data.data() + data.size()); }).get(); }) << "\n";
+
+    if (fork_join_sum != sum)
+        std::cerr << "tree_sum: wrong result\n";
+}
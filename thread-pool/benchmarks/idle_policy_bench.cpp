@@ -0,0 +1,61 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// wake-up latency vs. cpu burn of idle policies: tasks arrive one by one with a pause in between,
+// so workers are idle when each task is submitted
+// usage: idle_policy_bench [tasks] [gap_us] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+double percentile(std::vector<double> samples, double p)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[static_cast<size_t>(p * (samples.size() - 1))];
+}
+
+void measure(const std::string& name, ver_2_0::IdlePolicy policy, size_t thread_count, size_t tasks, std::chrono::microseconds gap)
+{
+    ver_2_0::ThreadPool pool(thread_count);
+    pool.set_idle_policy(policy);
+
+    std::vector<double> latencies;
+    latencies.reserve(tasks);
+
+    const std::clock_t cpu_start = std::clock();
+    const auto wall_start = Clock::now();
+
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        const auto submitted = Clock::now();
+        const auto started = pool.submit([] { return Clock::now(); }).get();
+        latencies.push_back(std::chrono::duration<double, std::micro>(started - submitted).count());
+
+        std::this_thread::sleep_for(gap);
+    }
+
+    const double wall_s = std::chrono::duration<double>(Clock::now() - wall_start).count();
+    const double cpu_s = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    std::cout << name << "," << thread_count << "," << policy.spin_count << "," << policy.yield_count << "," << policy.max_spinners << ","
+              << percentile(latencies, 0.5) << "," << percentile(latencies, 0.99) << "," << cpu_s / wall_s << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t tasks = argc > 1 ? std::stoul(argv[1]) : 2'000;
+    const std::chrono::microseconds gap {argc > 2 ? std::stol(argv[2]) : 100};
+    const size_t thread_count = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "policy,threads,spin_count,yield_count,max_spinners,p50_latency_us,p99_latency_us,cpu_cores_busy\n";
+    measure("park", ver_2_0::IdlePolicy::park(), thread_count, tasks, gap);
+    measure("spin_then_park", ver_2_0::IdlePolicy::spin_then_park(), thread_count, tasks, gap);
+    measure("long_spin_1_hot", ver_2_0::IdlePolicy::spin_then_park(100'000, 1'000, 1), thread_count, tasks, gap);
+    measure("long_spin_all_hot", ver_2_0::IdlePolicy::spin_then_park(100'000, 1'000, thread_count), thread_count, tasks, gap);
+}
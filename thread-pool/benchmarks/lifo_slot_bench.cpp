@@ -0,0 +1,101 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// tasks spawned from inside pool tasks - shared queue only vs. per-worker LIFO slot
+//  - spawn_tree: every task posts two children until the given depth (pure scheduling overhead)
+//  - pipeline: independent chains of stages, each stage updates a 32KB block and posts the next stage
+//    (the block is cache-hot only if the next stage runs right away on the same core)
+// usage: lifo_slot_bench [tree_depth] [chains] [stages] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+void spawn_tree(ver_2_0::ThreadPool& pool, size_t depth, std::latch& done)
+{
+    if (depth == 0)
+    {
+        done.count_down();
+        return;
+    }
+
+    pool.post([&pool, depth, &done] { spawn_tree(pool, depth - 1, done); });
+    pool.post([&pool, depth, &done] { spawn_tree(pool, depth - 1, done); });
+}
+
+struct Chain
+{
+    std::vector<uint32_t> block = std::vector<uint32_t>(8 * 1024);
+    uint64_t checksum = 0;
+};
+
+void pipeline_stage(ver_2_0::ThreadPool& pool, Chain& chain, size_t stage, std::latch& done)
+{
+    for (auto& x : chain.block)
+        x = x * 2654435761u + static_cast<uint32_t>(stage);
+    chain.checksum += std::accumulate(chain.block.begin(), chain.block.end(), uint64_t {0});
+
+    if (stage == 0)
+    {
+        done.count_down();
+        return;
+    }
+
+    pool.post([&pool, &chain, stage, &done] { pipeline_stage(pool, chain, stage - 1, done); });
+}
+
+template <typename F>
+double measure_ms(F f)
+{
+    const auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void measure(const std::string& mode, bool lifo_slot, size_t thread_count, size_t depth, size_t chain_count, size_t stages)
+{
+    ver_2_0::ThreadPool pool(thread_count);
+    if (lifo_slot)
+        pool.enable_lifo_slot();
+
+    const double tree_ms = measure_ms([&] {
+        std::latch done {static_cast<std::ptrdiff_t>(size_t {1} << depth)};
+        pool.post([&] { spawn_tree(pool, depth, done); });
+        done.wait();
+    });
+
+    std::vector<Chain> chains(chain_count);
+    const double pipeline_ms = measure_ms([&] {
+        std::latch done {static_cast<std::ptrdiff_t>(chain_count)};
+        for (auto& chain : chains)
+            pool.post([&pool, &chain, stages, &done] { pipeline_stage(pool, chain, stages, done); });
+        done.wait();
+    });
+
+    std::cout << "spawn_tree," << mode << "," << thread_count << "," << ((size_t {2} << depth) - 1) << "," << tree_ms << "\n";
+    std::cout << "pipeline," << mode << "," << thread_count << "," << chain_count * (stages + 1) << "," << pipeline_ms << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t depth = argc > 1 ? std::stoul(argv[1]) : 20;
+    const size_t chain_count = argc > 2 ? std::stoul(argv[2]) : 256;
+    const size_t stages = argc > 3 ? std::stoul(argv[3]) : 200;
+    const size_t thread_count = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "benchmark,mode,threads,tasks,time_ms\n";
+    for (int run = 0; run < 2; ++run)
+    {
+        measure("shared_queue", false, thread_count, depth, chain_count, stages);
+        measure("lifo_slot", true, thread_count, depth, chain_count, stages);
+    }
+}
@@ -0,0 +1,54 @@
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// overhead of metrics collection & sample snapshot
+// usage: metrics_bench [task_count] [thread_count]
+
+double throughput(ver_2_0::ThreadPool& pool, size_t task_count)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    auto results = pool.submit_n(task_count, [](size_t i) { return i * i; });
+    for (auto& r : results)
+        r.get();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return task_count / std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t task_count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    const double without_metrics = throughput(pool, task_count);
+    pool.enable_metrics();
+    const double with_metrics = throughput(pool, task_count);
+
+    std::cout << "metrics,threads,tasks_per_sec\n";
+    std::cout << "off," << thread_count << "," << without_metrics << "\n";
+    std::cout << "on," << thread_count << "," << with_metrics << "\n\n";
+
+    const auto snapshot = pool.metrics();
+
+    std::cout << "worker,tasks_executed,busy_ms,idle_ms,busy_ratio\n";
+    for (size_t i = 0; i < snapshot.workers.size(); ++i)
+    {
+        const auto& w = snapshot.workers[i];
+        std::cout << i << "," << w.tasks_executed << "," << w.busy_time.count() / 1e6 << "," << w.idle_time.count() / 1e6 << "," << w.busy_ratio() << "\n";
+    }
+
+    std::cout << "\nhistogram,p50_ns,p90_ns,p99_ns,count\n";
+    std::cout << "queue_wait," << snapshot.queue_wait.percentile(0.5).count() << "," << snapshot.queue_wait.percentile(0.9).count() << ","
+              << snapshot.queue_wait.percentile(0.99).count() << "," << snapshot.queue_wait.count() << "\n";
+    std::cout << "run_time," << snapshot.run_time.percentile(0.5).count() << "," << snapshot.run_time.percentile(0.9).count() << ","
+              << snapshot.run_time.percentile(0.99).count() << "," << snapshot.run_time.count() << "\n";
+    std::cout << "\nqueue_depth," << snapshot.queue_depth << "\n";
+}
@@ -0,0 +1,93 @@
+#include "cpu_topology.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+// memory-bound benchmark: every buffer is first-touched by a pool task and then
+// summed over and over by a chain of follow-up tasks submitted from the pool
+// usage: numa_bench [buffer_mb] [buffer_count] [passes] [topology, e.g. "0-3;4-7"]
+
+struct Buffer
+{
+    std::unique_ptr<double[]> data;
+    size_t size;
+    double sum = 0;
+};
+
+template <typename TPool>
+void sum_pass(TPool& pool, Buffer& buffer, size_t passes_left, std::atomic<size_t>& chains_left, ver_2_0::Promise<void>& done)
+{
+    buffer.sum += std::accumulate(buffer.data.get(), buffer.data.get() + buffer.size, 0.0);
+
+    if (passes_left > 1)
+        pool.post([&pool, &buffer, passes_left, &chains_left, &done] { sum_pass(pool, buffer, passes_left - 1, chains_left, done); });
+    else if (chains_left.fetch_sub(1) == 1)
+        done.set_value();
+}
+
+template <typename TPool>
+double memory_bandwidth(TPool& pool, size_t buffer_size, size_t buffer_count, size_t passes)
+{
+    std::vector<Buffer> buffers(buffer_count);
+    std::atomic<size_t> chains_left {buffer_count};
+    ver_2_0::Promise<void> done(nullptr);
+    auto f_done = done.get_future();
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (auto& buffer : buffers)
+        pool.post([&pool, &buffer, buffer_size, passes, &chains_left, &done] {
+            buffer.data.reset(new double[buffer_size]); // first touch happens on the worker
+            buffer.size = buffer_size;
+            std::fill_n(buffer.data.get(), buffer_size, 1.0);
+            sum_pass(pool, buffer, passes, chains_left, done);
+        });
+
+    f_done.get();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double bytes = static_cast<double>(buffer_size) * sizeof(double) * buffer_count * (passes + 1);
+    return bytes / std::chrono::duration<double>(end - start).count() / 1e9;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t buffer_mb = argc > 1 ? std::stoul(argv[1]) : 64;
+    const size_t buffer_count = argc > 2 ? std::stoul(argv[2]) : 2 * std::max(1u, std::thread::hardware_concurrency());
+    const size_t passes = argc > 3 ? std::stoul(argv[3]) : 10;
+    const CpuTopology topology = argc > 4 ? CpuTopology::from_description(argv[4]) : CpuTopology::from_sysfs();
+
+    size_t thread_count = 0;
+    for (size_t node = 0; node < topology.node_count(); ++node)
+        thread_count += topology.cpus(node).size();
+
+    const size_t buffer_size = buffer_mb * 1024 * 1024 / sizeof(double);
+
+    std::cout << "pool,threads,numa_nodes,bandwidth_gb_per_sec\n";
+
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+        std::cout << "unpinned," << thread_count << "," << topology.node_count() << ","
+                  << memory_bandwidth(pool, buffer_size, buffer_count, passes) << std::endl;
+    }
+
+    {
+        ver_2_0::NumaThreadPool pool(thread_count, topology, false);
+        std::cout << "numa_queues," << thread_count << "," << topology.node_count() << ","
+                  << memory_bandwidth(pool, buffer_size, buffer_count, passes) << std::endl;
+    }
+
+    {
+        ver_2_0::NumaThreadPool pool(thread_count, topology, true);
+        std::cout << "numa_queues+pinned," << thread_count << "," << topology.node_count() << ","
+                  << memory_bandwidth(pool, buffer_size, buffer_count, passes) << std::endl;
+    }
+}
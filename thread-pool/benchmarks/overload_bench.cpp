@@ -0,0 +1,91 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// a producer submitting faster than the pool can run tasks - unbounded queue vs. bounded queue
+// with each overflow policy: queue high-water mark, tasks run/dropped/refused and the queue wait
+// of the tasks that ran
+// usage: overload_bench [tasks] [capacity] [task_us] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+void busy_for(std::chrono::microseconds duration)
+{
+    const auto until = Clock::now() + duration;
+    while (Clock::now() < until)
+    {
+    }
+}
+
+void measure(const std::string& name, ver_2_0::ThreadPool& pool, size_t tasks, std::chrono::microseconds task_time)
+{
+    std::atomic<size_t> executed {0};
+    std::atomic<int64_t> max_wait_us {0};
+    size_t refused = 0;
+
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < tasks; ++i)
+    {
+        const auto submitted = Clock::now();
+        try
+        {
+            pool.post([&, submitted] {
+                const int64_t wait_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - submitted).count();
+                int64_t max_wait = max_wait_us.load(std::memory_order_relaxed);
+                while (wait_us > max_wait && !max_wait_us.compare_exchange_weak(max_wait, wait_us))
+                {
+                }
+
+                busy_for(task_time);
+                ++executed;
+            });
+        }
+        catch (const QueueFullError&)
+        {
+            ++refused;
+        }
+    }
+
+    const auto submitted_all = Clock::now();
+
+    while (executed + refused + pool.dropped_task_count() < tasks)
+        std::this_thread::sleep_for(std::chrono::milliseconds {1});
+
+    std::cout << name << "," << pool.queue_high_water_mark() << "," << executed << "," << pool.dropped_task_count() << "," << refused << ","
+              << std::chrono::duration<double, std::milli>(submitted_all - start).count() << "," << max_wait_us / 1000.0 << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t tasks = argc > 1 ? std::stoul(argv[1]) : 50'000;
+    const size_t capacity = argc > 2 ? std::stoul(argv[2]) : 256;
+    const std::chrono::microseconds task_time {argc > 3 ? std::stol(argv[3]) : 20};
+    const size_t thread_count = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "queue,high_water_mark,executed,dropped,refused,submit_ms,max_queue_wait_ms\n";
+
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+        measure("unbounded", pool, tasks, task_time);
+    }
+
+    const std::pair<const char*, OverflowPolicy> policies[] = {
+        {"block", OverflowPolicy::block},
+        {"fail", OverflowPolicy::fail},
+        {"caller_runs", OverflowPolicy::caller_runs},
+        {"drop_oldest", OverflowPolicy::drop_oldest}};
+
+    for (const auto& [name, policy] : policies)
+    {
+        ver_2_0::ThreadPool pool(thread_count, capacity, policy);
+        measure(name, pool, tasks, task_time);
+    }
+}
@@ -0,0 +1,104 @@
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Monte Carlo Pi strategies from _exercises/monte-carlo-pi ported onto the thread pool
+// usage: pi_bench [N] [thread_count]
+
+long count_hits(long count, std::mt19937_64::result_type seed)
+{
+    long hits = 0;
+    std::mt19937_64 rand_engine {seed};
+    std::uniform_real_distribution<double> rand_distr {0.0, 1.0};
+
+    for (long n = 0; n < count; ++n)
+    {
+        double x = rand_distr(rand_engine);
+        double y = rand_distr(rand_engine);
+        if (x * x + y * y < 1)
+            hits++;
+    }
+
+    return hits;
+}
+
+template <typename F>
+void measure(const std::string& strategy, size_t thread_count, long N, F calculate_hits)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    const long hits = calculate_hits();
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    const double pi = static_cast<double>(hits) / N * 4;
+    const auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    std::cout << strategy << "," << thread_count << "," << pi << "," << elapsed_time << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const long N = argc > 1 ? std::stol(argv[1]) : 100'000'000;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "strategy,threads,pi,elapsed_ms\n";
+
+    measure("single_thread", 1, N, [N] { return count_hits(N, 42); });
+
+    measure("std::thread", thread_count, N, [=] {
+        std::vector<std::thread> threads(thread_count);
+        std::vector<long> partial_hits(thread_count);
+
+        for (size_t i = 0; i < thread_count; ++i)
+            threads[i] = std::thread([&partial_hits, i, count = N / static_cast<long>(thread_count)] { partial_hits[i] = count_hits(count, i); });
+
+        for (auto& thd : threads)
+            thd.join();
+
+        return std::accumulate(partial_hits.begin(), partial_hits.end(), 0L);
+    });
+
+    measure("std::async", thread_count, N, [=] {
+        std::vector<std::future<long>> partial_hits(thread_count);
+
+        for (size_t i = 0; i < thread_count; ++i)
+            partial_hits[i] = std::async(std::launch::async, count_hits, N / static_cast<long>(thread_count), i);
+
+        long hits = 0;
+        for (auto& ph : partial_hits)
+            hits += ph.get();
+        return hits;
+    });
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    measure("parallel_reduce", thread_count, N, [&pool, N] {
+        return ver_2_0::parallel_reduce(
+            pool, 0L, N, 0L,
+            [](long first, long last) { return count_hits(last - first, first); },
+            std::plus<long> {});
+    });
+
+    measure("parallel_for+atomic", thread_count, N, [&pool, N] {
+        const long chunk_size = 1'000'000;
+        const long chunk_count = (N + chunk_size - 1) / chunk_size;
+        std::atomic<long> hits {0};
+
+        ver_2_0::parallel_for(pool, 0L, chunk_count, [&hits, N, chunk_size](long chunk) {
+            const long count = std::min(chunk_size, N - chunk * chunk_size);
+            hits.fetch_add(count_hits(count, chunk), std::memory_order_relaxed);
+        }, 1);
+
+        return hits.load();
+    });
+}
@@ -0,0 +1,429 @@
+#include "elastic_thread_pool.hpp"
+#include "thread_pool.hpp"
+#include "work_stealing_thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <latch>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// benchmark suite - every scenario on every selected backend across a sweep of thread counts
+//  - empty_tasks:      throughput of empty fire & forget tasks
+//  - submit_latency:   time spent in the submitting call (p50/p99)
+//  - round_trip:       submit + get() of a trivial task, one at a time (p50/p99)
+//  - fan_out_fan_in:   rounds of 64 small tasks, each round waits for all results
+//  - recursive_spawn:  binary tree of tasks posted from inside tasks
+//  - mixed:            5% long (1ms) & 95% short (10us) tasks - makespan and p99 latency of short tasks
+// usage: pool_bench [--backends=ver_1_0,ver_2_0,...] [--threads=1,2,4] [--scenarios=...] [--scale=1.0] [--format=csv|json]
+
+using Clock = std::chrono::steady_clock;
+
+//////////////////////////////////////////////////////////////////////
+// backends - post(f) fire & forget, submit(f) returns something with get()
+
+template <typename TPool>
+class PoolBackend
+{
+public:
+    explicit PoolBackend(size_t thread_count)
+        : pool_ {make_pool(thread_count)}
+    {
+    }
+
+    template <typename F>
+    void post(F&& f)
+    {
+        if constexpr (requires { pool_->post(Task {}); })
+            pool_->post(Task {std::forward<F>(f)});
+        else
+            pool_->submit(std::forward<F>(f));
+    }
+
+    template <typename F>
+    auto submit(F&& f)
+    {
+        if constexpr (!std::is_void_v<decltype(pool_->submit(std::forward<F>(f)))>)
+            return pool_->submit(std::forward<F>(f));
+        else
+        {
+            // ver_1_0 has no futures
+            using ResultT = decltype(f());
+            std::promise<ResultT> promise;
+            std::future<ResultT> f_result = promise.get_future();
+            pool_->submit(Task {[promise = std::move(promise), f = std::forward<F>(f)]() mutable
+                {
+                    if constexpr (std::is_void_v<ResultT>)
+                    {
+                        f();
+                        promise.set_value();
+                    }
+                    else
+                        promise.set_value(f());
+                }});
+            return f_result;
+        }
+    }
+
+protected:
+    std::unique_ptr<TPool> pool_;
+
+private:
+    static std::unique_ptr<TPool> make_pool(size_t thread_count)
+    {
+        if constexpr (std::is_same_v<TPool, ver_2_0::ElasticThreadPool>)
+            return std::make_unique<TPool>(ver_2_0::ElasticOptions {1, thread_count});
+        else
+            return std::make_unique<TPool>(thread_count);
+    }
+};
+
+class LifoSlotBackend : public PoolBackend<ver_2_0::ThreadPool>
+{
+public:
+    explicit LifoSlotBackend(size_t thread_count)
+        : PoolBackend {thread_count}
+    {
+        pool_->enable_lifo_slot();
+    }
+};
+
+//////////////////////////////////////////////////////////////////////
+// results
+
+struct Result
+{
+    std::string scenario;
+    std::string backend;
+    size_t threads = 0;
+    size_t ops = 0;
+    double time_ms = 0;
+    double p50_us = -1; // -1 - not measured
+    double p99_us = -1;
+
+    double ops_per_sec() const
+    {
+        return time_ms > 0 ? ops / (time_ms / 1000.0) : 0;
+    }
+};
+
+double elapsed_ms(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double percentile_us(std::vector<Clock::duration>& samples, double p)
+{
+    if (samples.empty())
+        return -1;
+
+    const size_t n = static_cast<size_t>(p * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+    return std::chrono::duration<double, std::micro>(samples[n]).count();
+}
+
+std::atomic<uint64_t> checksum {0}; // keeps the work of fan_out_fan_in observable
+
+void busy_for(std::chrono::microseconds duration)
+{
+    const auto until = Clock::now() + duration;
+    while (Clock::now() < until)
+    {
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// scenarios
+
+template <typename TBackend>
+Result empty_tasks(TBackend& backend, size_t task_count)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(task_count)};
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < task_count; ++i)
+        backend.post([&done] { done.count_down(); });
+    done.wait();
+
+    return Result {"empty_tasks", "", 0, task_count, elapsed_ms(start)};
+}
+
+template <typename TBackend>
+Result submit_latency(TBackend& backend, size_t task_count)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(task_count)};
+    std::vector<Clock::duration> samples(task_count);
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < task_count; ++i)
+    {
+        const auto before = Clock::now();
+        backend.post([&done] { done.count_down(); });
+        samples[i] = Clock::now() - before;
+    }
+    const double time_ms = elapsed_ms(start);
+    done.wait();
+
+    return Result {"submit_latency", "", 0, task_count, time_ms, percentile_us(samples, 0.5), percentile_us(samples, 0.99)};
+}
+
+template <typename TBackend>
+Result round_trip(TBackend& backend, size_t task_count)
+{
+    std::vector<Clock::duration> samples(task_count);
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < task_count; ++i)
+    {
+        const auto before = Clock::now();
+        backend.submit([i] { return i; }).get();
+        samples[i] = Clock::now() - before;
+    }
+
+    return Result {"round_trip", "", 0, task_count, elapsed_ms(start), percentile_us(samples, 0.5), percentile_us(samples, 0.99)};
+}
+
+template <typename TBackend>
+Result fan_out_fan_in(TBackend& backend, size_t rounds)
+{
+    constexpr size_t fan_out = 64;
+    std::vector<Clock::duration> samples(rounds);
+
+    const auto start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        const auto before = Clock::now();
+
+        using FutureT = decltype(backend.submit([] { return uint64_t {}; }));
+        std::vector<FutureT> f_results;
+        f_results.reserve(fan_out);
+        for (size_t i = 0; i < fan_out; ++i)
+            f_results.push_back(backend.submit([i] {
+                uint64_t x = i;
+                for (int k = 0; k < 1'000; ++k)
+                    x = x * 6364136223846793005u + 1442695040888963407u;
+                return x;
+            }));
+
+        uint64_t sum = 0;
+        for (auto& f : f_results)
+            sum += f.get();
+
+        samples[r] = Clock::now() - before;
+        checksum.fetch_add(sum, std::memory_order_relaxed);
+    }
+
+    return Result {"fan_out_fan_in", "", 0, rounds * fan_out, elapsed_ms(start), percentile_us(samples, 0.5), percentile_us(samples, 0.99)};
+}
+
+template <typename TBackend>
+void spawn_tree(TBackend& backend, size_t depth, std::latch& done)
+{
+    if (depth == 0)
+    {
+        done.count_down();
+        return;
+    }
+
+    backend.post([&backend, depth, &done] { spawn_tree(backend, depth - 1, done); });
+    backend.post([&backend, depth, &done] { spawn_tree(backend, depth - 1, done); });
+}
+
+template <typename TBackend>
+Result recursive_spawn(TBackend& backend, size_t task_count)
+{
+    size_t depth = 1;
+    while ((size_t {4} << depth) - 1 <= task_count)
+        ++depth;
+
+    std::latch done {static_cast<std::ptrdiff_t>(size_t {1} << depth)};
+
+    const auto start = Clock::now();
+    backend.post([&] { spawn_tree(backend, depth, done); });
+    done.wait();
+
+    return Result {"recursive_spawn", "", 0, (size_t {2} << depth) - 1, elapsed_ms(start)};
+}
+
+template <typename TBackend>
+Result mixed(TBackend& backend, size_t task_count)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(task_count)};
+    std::vector<Clock::duration> short_latencies(task_count);
+    std::atomic<size_t> short_count {0};
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < task_count; ++i)
+    {
+        const auto submitted = Clock::now();
+        if (i % 20 == 0)
+            backend.post([&done] {
+                busy_for(std::chrono::microseconds {1'000});
+                done.count_down();
+            });
+        else
+            backend.post([&, submitted] {
+                busy_for(std::chrono::microseconds {10});
+                short_latencies[short_count++] = Clock::now() - submitted;
+                done.count_down();
+            });
+    }
+    done.wait();
+    const double time_ms = elapsed_ms(start);
+
+    short_latencies.resize(short_count);
+    return Result {"mixed", "", 0, task_count, time_ms, percentile_us(short_latencies, 0.5), percentile_us(short_latencies, 0.99)};
+}
+
+//////////////////////////////////////////////////////////////////////
+// driver
+
+struct Options
+{
+    std::vector<std::string> backends {"ver_1_0", "ver_2_0", "ver_2_0_lock_free", "ver_2_0_lifo_slot", "ver_2_0_elastic", "ver_3_0"};
+    std::vector<size_t> threads;
+    std::vector<std::string> scenarios {"empty_tasks", "submit_latency", "round_trip", "fan_out_fan_in", "recursive_spawn", "mixed"};
+    double scale = 1.0;
+    bool json = false;
+};
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::istringstream in {text};
+    for (std::string item; std::getline(in, item, ',');)
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+template <typename TBackend>
+Result run_scenario(const std::string& scenario, size_t thread_count, double scale)
+{
+    const auto scaled = [scale](size_t n) { return std::max<size_t>(1, static_cast<size_t>(n * scale)); };
+
+    TBackend backend(thread_count);
+
+    if (scenario == "empty_tasks")
+        return empty_tasks(backend, scaled(500'000));
+    if (scenario == "submit_latency")
+        return submit_latency(backend, scaled(200'000));
+    if (scenario == "round_trip")
+        return round_trip(backend, scaled(20'000));
+    if (scenario == "fan_out_fan_in")
+        return fan_out_fan_in(backend, scaled(2'000));
+    if (scenario == "recursive_spawn")
+        return recursive_spawn(backend, scaled(500'000));
+    if (scenario == "mixed")
+        return mixed(backend, scaled(20'000));
+
+    throw std::invalid_argument("Unknown scenario: " + scenario);
+}
+
+using ScenarioRunner = std::function<Result(const std::string&, size_t, double)>;
+
+const std::map<std::string, ScenarioRunner> backends {
+    {"ver_1_0", run_scenario<PoolBackend<ver_1_0::ThreadPool>>},
+    {"ver_2_0", run_scenario<PoolBackend<ver_2_0::ThreadPool>>},
+    {"ver_2_0_lock_free", run_scenario<PoolBackend<ver_2_0::LockFreeThreadPool>>},
+    {"ver_2_0_lifo_slot", run_scenario<LifoSlotBackend>},
+    {"ver_2_0_elastic", run_scenario<PoolBackend<ver_2_0::ElasticThreadPool>>},
+    {"ver_3_0", run_scenario<PoolBackend<ver_3_0::ThreadPool>>}};
+
+void print(const Result& r, bool json, bool first)
+{
+    if (json)
+    {
+        std::cout << (first ? "[\n" : ",\n") << "  {\"scenario\": \"" << r.scenario << "\", \"backend\": \"" << r.backend
+                  << "\", \"threads\": " << r.threads << ", \"ops\": " << r.ops << ", \"time_ms\": " << r.time_ms
+                  << ", \"ops_per_sec\": " << r.ops_per_sec();
+        if (r.p50_us >= 0)
+            std::cout << ", \"p50_us\": " << r.p50_us << ", \"p99_us\": " << r.p99_us;
+        std::cout << "}" << std::flush;
+    }
+    else
+    {
+        if (first)
+            std::cout << "scenario,backend,threads,ops,time_ms,ops_per_sec,p50_us,p99_us\n";
+        std::cout << r.scenario << "," << r.backend << "," << r.threads << "," << r.ops << "," << r.time_ms << "," << r.ops_per_sec() << ",";
+        if (r.p50_us >= 0)
+            std::cout << r.p50_us << "," << r.p99_us;
+        else
+            std::cout << ",";
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const auto value = arg.substr(arg.find('=') + 1);
+
+        if (arg.starts_with("--backends="))
+            options.backends = split(value);
+        else if (arg.starts_with("--threads="))
+        {
+            options.threads.clear();
+            for (const auto& t : split(value))
+                options.threads.push_back(std::stoul(t));
+        }
+        else if (arg.starts_with("--scenarios="))
+            options.scenarios = split(value);
+        else if (arg.starts_with("--scale="))
+            options.scale = std::stod(value);
+        else if (arg == "--format=json")
+            options.json = true;
+        else if (arg != "--format=csv")
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    // 1, 2, 4, ... up to hardware_concurrency
+    if (options.threads.empty())
+    {
+        const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t t = 1; t < max_threads; t *= 2)
+            options.threads.push_back(t);
+        options.threads.push_back(max_threads);
+    }
+
+    bool first = true;
+    for (const auto& scenario : options.scenarios)
+        for (const auto& backend : options.backends)
+        {
+            const auto runner = backends.find(backend);
+            if (runner == backends.end())
+            {
+                std::cerr << "unknown backend: " << backend << "\n";
+                return 1;
+            }
+
+            for (size_t thread_count : options.threads)
+            {
+                Result result = runner->second(scenario, thread_count, options.scale);
+                result.backend = backend;
+                result.threads = thread_count;
+                print(result, options.json, first);
+                first = false;
+            }
+        }
+
+    if (options.json && !first)
+        std::cout << "\n]\n";
+}
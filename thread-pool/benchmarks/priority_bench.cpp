@@ -0,0 +1,75 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// p99 queueing delay of high priority tasks while the pool is saturated with background work
+// usage: priority_bench [thread_count] [background_tasks] [high_tasks]
+
+using Clock = std::chrono::steady_clock;
+
+void busy_work(std::chrono::microseconds duration)
+{
+    const auto end = Clock::now() + duration;
+    while (Clock::now() < end)
+        ;
+}
+
+double percentile(std::vector<double> samples, double p)
+{
+    std::sort(samples.begin(), samples.end());
+    const auto index = static_cast<size_t>(p * (samples.size() - 1));
+    return samples[index];
+}
+
+template <typename TPool, typename TSubmit>
+std::vector<double> high_priority_delays(size_t thread_count, size_t background_tasks, size_t high_tasks, TSubmit submit)
+{
+    TPool pool(thread_count);
+
+    std::vector<ver_2_0::Future<void>> background;
+    background.reserve(background_tasks);
+    for (size_t i = 0; i < background_tasks; ++i)
+        background.push_back(submit(pool, TaskPriority::background, [] { busy_work(std::chrono::microseconds(200)); }));
+
+    std::vector<ver_2_0::Future<double>> delays;
+    delays.reserve(high_tasks);
+    for (size_t i = 0; i < high_tasks; ++i)
+    {
+        const auto submitted = Clock::now();
+        delays.push_back(submit(pool, TaskPriority::high, [submitted] {
+            return std::chrono::duration<double, std::micro>(Clock::now() - submitted).count();
+        }));
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    std::vector<double> result;
+    for (auto& d : delays)
+        result.push_back(d.get());
+
+    for (auto& b : background)
+        b.get();
+
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t thread_count = argc > 1 ? std::stoul(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    const size_t background_tasks = argc > 2 ? std::stoul(argv[2]) : 5'000;
+    const size_t high_tasks = argc > 3 ? std::stoul(argv[3]) : 200;
+
+    const auto fifo = high_priority_delays<ver_2_0::ThreadPool>(thread_count, background_tasks, high_tasks,
+        [](auto& pool, TaskPriority, auto f) { return pool.submit(std::move(f)); });
+
+    const auto lanes = high_priority_delays<ver_2_0::PriorityThreadPool>(thread_count, background_tasks, high_tasks,
+        [](auto& pool, TaskPriority priority, auto f) { return pool.submit(priority, std::move(f)); });
+
+    std::cout << "queue,threads,p50_us,p99_us,max_us\n";
+    std::cout << "fifo," << thread_count << "," << percentile(fifo, 0.5) << "," << percentile(fifo, 0.99) << "," << percentile(fifo, 1.0) << "\n";
+    std::cout << "priority_lanes," << thread_count << "," << percentile(lanes, 0.5) << "," << percentile(lanes, 0.99) << "," << percentile(lanes, 1.0) << "\n";
+}
@@ -0,0 +1,93 @@
+#include "mpmc_queue.hpp"
+#include "thread_pool.hpp"
+#include "thread_safe_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// usage: queue_bench [item_count] [max_threads]
+
+template <typename TQueue>
+double producers_consumers(size_t producer_count, size_t consumer_count, size_t item_count)
+{
+    TQueue queue;
+    const size_t items_per_producer = item_count / producer_count;
+    const size_t total = items_per_producer * producer_count;
+    std::atomic<size_t> consumed {0};
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producer_count; ++p)
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < items_per_producer; ++i)
+                queue.push(static_cast<int>(i));
+        });
+
+    for (size_t c = 0; c < consumer_count; ++c)
+        threads.emplace_back([&] {
+            int item;
+            while (consumed.load(std::memory_order_relaxed) < total)
+            {
+                if (queue.try_pop(item))
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+    for (auto& thd : threads)
+        thd.join();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return total / std::chrono::duration<double>(end - start).count();
+}
+
+template <typename TPool>
+double pool_throughput(size_t thread_count, size_t task_count)
+{
+    TPool pool(thread_count);
+    std::atomic<size_t> counter {0};
+    std::promise<void> done;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < task_count; ++i)
+        pool.submit([&] {
+            if (counter.fetch_add(1) + 1 == task_count)
+                done.set_value();
+        });
+
+    done.get_future().wait();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return task_count / std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t item_count = argc > 1 ? std::stoul(argv[1]) : 1'000'000;
+    const size_t max_threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "scenario,threads,thread_safe_queue_ops_per_sec,bounded_mpmc_queue_ops_per_sec\n";
+
+    for (size_t threads = 1; threads <= max_threads; ++threads)
+    {
+        std::cout << "producers_consumers," << threads << ","
+                  << producers_consumers<ThreadSafeQueue<int>>(threads, threads, item_count) << ","
+                  << producers_consumers<BoundedMpmcQueue<int>>(threads, threads, item_count) << std::endl;
+    }
+
+    for (size_t threads = 1; threads <= max_threads; ++threads)
+    {
+        std::cout << "thread_pool," << threads << ","
+                  << pool_throughput<ver_2_0::ThreadPool>(threads, item_count / 4) << ","
+                  << pool_throughput<ver_2_0::LockFreeThreadPool>(threads, item_count / 4) << std::endl;
+    }
+}
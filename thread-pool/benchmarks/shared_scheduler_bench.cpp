@@ -0,0 +1,114 @@
+#include "shared_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// several subsystems submitting at the same time:
+//  - separate: every subsystem owns a ThreadPool of thread_count workers (subsystems x thread_count threads)
+//  - shared: every subsystem owns a PoolView on one SharedScheduler of thread_count workers
+// followed by the run-time shares of backlogged views with weights 1, 2 & 4
+// usage: shared_scheduler_bench [subsystems] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+void busy_for(std::chrono::microseconds duration)
+{
+    const auto until = Clock::now() + duration;
+    while (Clock::now() < until)
+    {
+    }
+}
+
+// every subsystem posts its tasks from its own thread; the time until all tasks are done
+template <typename TExecutor>
+double subsystems_ms(std::vector<std::unique_ptr<TExecutor>>& executors, size_t tasks, std::chrono::microseconds task_time)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(executors.size() * tasks)};
+
+    const auto start = Clock::now();
+
+    std::vector<std::thread> producers;
+    for (auto& executor : executors)
+        producers.emplace_back([&, executor = executor.get()] {
+            for (size_t i = 0; i < tasks; ++i)
+                executor->post([&done, task_time] {
+                    busy_for(task_time);
+                    done.count_down();
+                });
+        });
+
+    for (auto& producer : producers)
+        producer.join();
+    done.wait();
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t subsystems = argc > 1 ? std::stoul(argv[1]) : 4;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "mode,subsystems,threads,task_us,tasks,time_ms\n";
+
+    for (const auto& [task_time, tasks] : {std::pair {std::chrono::microseconds {0}, size_t {200'000}}, std::pair {std::chrono::microseconds {20}, size_t {20'000}}})
+    {
+        {
+            std::vector<std::unique_ptr<ver_2_0::ThreadPool>> pools;
+            for (size_t i = 0; i < subsystems; ++i)
+                pools.push_back(std::make_unique<ver_2_0::ThreadPool>(thread_count));
+
+            std::cout << "separate," << subsystems << "," << subsystems * thread_count << "," << task_time.count() << "," << tasks << ","
+                      << subsystems_ms(pools, tasks, task_time) << std::endl;
+        }
+
+        {
+            ver_2_0::SharedScheduler scheduler {thread_count};
+            std::vector<std::unique_ptr<ver_2_0::PoolView>> views;
+            for (size_t i = 0; i < subsystems; ++i)
+                views.push_back(std::make_unique<ver_2_0::PoolView>(scheduler));
+
+            std::cout << "shared," << subsystems << "," << thread_count << "," << task_time.count() << "," << tasks << ","
+                      << subsystems_ms(views, tasks, task_time) << std::endl;
+        }
+    }
+
+    // all views backlogged for a while - run time should split 1:2:4
+    std::cout << "\nweight,busy_ms,share\n";
+
+    ver_2_0::SharedScheduler scheduler {thread_count};
+    std::atomic<bool> stop {false};
+    std::vector<std::unique_ptr<ver_2_0::PoolView>> views;
+
+    for (size_t weight : {1, 2, 4})
+    {
+        views.push_back(std::make_unique<ver_2_0::PoolView>(scheduler, ver_2_0::PoolViewOptions {.weight = weight}));
+        for (size_t i = 0; i < 50'000; ++i)
+            views.back()->post([&stop] {
+                if (!stop.load(std::memory_order_relaxed))
+                    busy_for(std::chrono::microseconds {20});
+            });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {500});
+
+    std::vector<ver_2_0::PoolViewStats> stats;
+    for (auto& view : views)
+        stats.push_back(view->stats());
+    stop = true;
+
+    std::chrono::nanoseconds total {0};
+    for (const auto& s : stats)
+        total += s.busy_time;
+
+    for (size_t i = 0; i < stats.size(); ++i)
+        std::cout << (size_t {1} << i) << "," << stats[i].busy_time.count() / 1e6 << ","
+                  << static_cast<double>(stats[i].busy_time.count()) / total.count() << std::endl;
+}
@@ -0,0 +1,147 @@
+#include "strand.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// transfers between a few bank accounts (high contention) executed on a ThreadPool:
+// scoped_lock on both accounts (as in _exercises/synchronization) vs. one strand per account
+// usage: strand_bench [accounts] [transfers] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+class LockedAccount
+{
+public:
+    void transfer(LockedAccount& to, double amount)
+    {
+        std::scoped_lock lk {mtx_, to.mtx_};
+        balance_ -= amount;
+        to.balance_ += amount;
+    }
+
+    double balance() const
+    {
+        std::lock_guard lk {mtx_};
+        return balance_;
+    }
+
+private:
+    double balance_ = 0;
+    mutable std::mutex mtx_;
+};
+
+// balance_ is touched only by tasks of strand_ - no lock
+class StrandAccount
+{
+public:
+    explicit StrandAccount(ver_2_0::Executor& executor)
+        : strand_ {executor}
+    {
+    }
+
+    // withdraw on this account's strand, then deposit on the strand of the target
+    template <typename TDone>
+    void transfer(StrandAccount& to, double amount, TDone done)
+    {
+        strand_.post([this, &to, amount, done] {
+            balance_ -= amount;
+            to.strand_.post([&to, amount, done] {
+                to.balance_ += amount;
+                done();
+            });
+        });
+    }
+
+    double balance()
+    {
+        return strand_.submit([this] { return balance_; }).get();
+    }
+
+private:
+    double balance_ = 0;
+    ver_2_0::Strand strand_;
+};
+
+std::vector<std::pair<size_t, size_t>> random_transfers(size_t accounts, size_t transfers)
+{
+    std::mt19937 rnd {42};
+    std::uniform_int_distribution<size_t> distr {0, accounts - 1};
+
+    std::vector<std::pair<size_t, size_t>> result;
+    result.reserve(transfers);
+    while (result.size() < transfers)
+    {
+        const size_t from = distr(rnd);
+        const size_t to = distr(rnd);
+        if (from != to)
+            result.emplace_back(from, to);
+    }
+
+    return result;
+}
+
+template <typename TAccount, typename TTransfer>
+double run_ms(ver_2_0::ThreadPool& pool, std::vector<std::unique_ptr<TAccount>>& accounts,
+    const std::vector<std::pair<size_t, size_t>>& transfers, TTransfer transfer)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(transfers.size())};
+
+    const auto start = Clock::now();
+    for (const auto& [from, to] : transfers)
+        transfer(pool, *accounts[from], *accounts[to], done);
+    done.wait();
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t account_count = argc > 1 ? std::stoul(argv[1]) : 4;
+    const size_t transfer_count = argc > 2 ? std::stoul(argv[2]) : 1'000'000;
+    const size_t thread_count = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    const auto transfers = random_transfers(account_count, transfer_count);
+    ver_2_0::ThreadPool pool(thread_count);
+
+    std::vector<std::unique_ptr<LockedAccount>> locked_accounts;
+    for (size_t i = 0; i < account_count; ++i)
+        locked_accounts.push_back(std::make_unique<LockedAccount>());
+
+    const double locked_ms = run_ms(pool, locked_accounts, transfers, [](auto& pool, auto& from, auto& to, auto& done) {
+        pool.post([&from, &to, &done] {
+            from.transfer(to, 1.0);
+            done.count_down();
+        });
+    });
+
+    std::vector<std::unique_ptr<StrandAccount>> strand_accounts;
+    for (size_t i = 0; i < account_count; ++i)
+        strand_accounts.push_back(std::make_unique<StrandAccount>(pool));
+
+    const double strand_ms = run_ms(pool, strand_accounts, transfers, [](auto&, auto& from, auto& to, auto& done) {
+        from.transfer(to, 1.0, [&done] { done.count_down(); });
+    });
+
+    double locked_total = 0;
+    double strand_total = 0;
+    for (size_t i = 0; i < account_count; ++i)
+    {
+        locked_total += locked_accounts[i]->balance();
+        strand_total += strand_accounts[i]->balance();
+    }
+
+    if (locked_total != 0 || strand_total != 0)
+        std::cerr << "balances do not sum up to zero\n";
+
+    std::cout << "mode,threads,accounts,transfers,total_ms,transfers_per_s\n";
+    std::cout << "scoped_lock," << thread_count << "," << account_count << "," << transfer_count << "," << locked_ms << "," << transfer_count / locked_ms * 1000 << "\n";
+    std::cout << "strand," << thread_count << "," << account_count << "," << transfer_count << "," << strand_ms << "," << transfer_count / strand_ms * 1000 << "\n";
+}
@@ -0,0 +1,96 @@
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// wide (source -> width parallel nodes -> sink) and deep (chain) graphs:
+// TaskGraph vs. the same dependencies expressed with submit + get() level by level
+// usage: task_graph_bench [width] [depth] [runs] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+std::atomic<size_t> work_counter {0};
+
+void node_work()
+{
+    work_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void build_wide_graph(ver_2_0::TaskGraph& graph, size_t width)
+{
+    const auto source = graph.add(node_work);
+    const auto sink = graph.add(node_work);
+    for (size_t i = 0; i < width; ++i)
+    {
+        const auto node = graph.add(node_work);
+        graph.precede(source, node);
+        graph.precede(node, sink);
+    }
+}
+
+void build_deep_graph(ver_2_0::TaskGraph& graph, size_t depth)
+{
+    auto previous = graph.add(node_work);
+    for (size_t i = 1; i < depth; ++i)
+    {
+        const auto node = graph.add(node_work);
+        graph.precede(previous, node);
+        previous = node;
+    }
+}
+
+double graph_us_per_run(ver_2_0::ThreadPool& pool, ver_2_0::TaskGraph& graph, size_t runs)
+{
+    const auto start = Clock::now();
+    for (size_t r = 0; r < runs; ++r)
+        graph.run(pool).get();
+
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / runs;
+}
+
+// every level waits for the previous one
+double levels_us_per_run(ver_2_0::ThreadPool& pool, const std::vector<size_t>& level_widths, size_t runs)
+{
+    const auto start = Clock::now();
+    for (size_t r = 0; r < runs; ++r)
+    {
+        for (size_t width : level_widths)
+        {
+            std::vector<ver_2_0::Future<void>> level;
+            level.reserve(width);
+            for (size_t i = 0; i < width; ++i)
+                level.push_back(pool.submit(node_work));
+            for (auto& f : level)
+                f.get();
+        }
+    }
+
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / runs;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t width = argc > 1 ? std::stoul(argv[1]) : 1'000;
+    const size_t depth = argc > 2 ? std::stoul(argv[2]) : 1'000;
+    const size_t runs = argc > 3 ? std::stoul(argv[3]) : 100;
+    const size_t thread_count = argc > 4 ? std::stoul(argv[4]) : std::max(1u, std::thread::hardware_concurrency());
+
+    ver_2_0::ThreadPool pool(thread_count);
+
+    ver_2_0::TaskGraph wide;
+    build_wide_graph(wide, width);
+
+    ver_2_0::TaskGraph deep;
+    build_deep_graph(deep, depth);
+
+    std::cout << "graph,mode,threads,nodes,us_per_run\n";
+    std::cout << "wide,task_graph," << thread_count << "," << wide.size() << "," << graph_us_per_run(pool, wide, runs) << "\n";
+    std::cout << "wide,submit_get," << thread_count << "," << wide.size() << "," << levels_us_per_run(pool, {1, width, 1}, runs) << "\n";
+    std::cout << "deep,task_graph," << thread_count << "," << deep.size() << "," << graph_us_per_run(pool, deep, runs) << "\n";
+    std::cout << "deep,submit_get," << thread_count << "," << deep.size() << "," << levels_us_per_run(pool, std::vector<size_t>(depth, 1), runs) << "\n";
+}
@@ -0,0 +1,67 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// tear-down latency with a large backlog of empty tasks: the time from the shutdown call until
+// every worker has been joined
+//  - ver_2_0 (ThreadSafeQueue) - closed queue; abort takes the backlog out at once
+//  - ver_2_0_numa (NumaTaskQueue) - no close(): one stop task per worker behind the backlog
+// usage: teardown_bench [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+// workers are held by gate tasks while the backlog is queued, so every run starts with a full queue
+template <typename TPool, typename TSubmit, typename TShutdown>
+double teardown_ms(size_t thread_count, size_t backlog, TSubmit submit, TShutdown shutdown)
+{
+    auto pool = std::make_unique<TPool>(thread_count);
+
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+    for (size_t i = 0; i < thread_count; ++i)
+        submit(*pool, [opened] { opened.wait(); });
+
+    for (size_t i = 0; i < backlog; ++i)
+        submit(*pool, [] {});
+
+    // the clock starts before the gate opens - released workers may preempt this thread at once
+    const auto start = Clock::now();
+    shutdown(pool, gate);
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t thread_count = argc > 1 ? std::stoul(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+
+    const auto submit_1_0 = [](ver_1_0::ThreadPool& pool, auto f) { pool.submit(std::move(f)); };
+    const auto post = [](auto& pool, auto f) { pool.post(std::move(f)); };
+    const auto destroy = [](auto& pool, std::promise<void>& gate) {
+        gate.set_value();
+        pool.reset();
+    };
+    // the backlog is cancelled before the gate tasks complete
+    const auto abort = [](auto& pool, std::promise<void>& gate) {
+        pool->shutdown_now();
+        gate.set_value();
+        pool->shutdown(ver_2_0::ShutdownMode::abort);
+    };
+
+    std::cout << "pool,mode,threads,backlog,teardown_ms\n";
+
+    for (size_t backlog : {10'000, 100'000, 1'000'000})
+    {
+        std::cout << "ver_1_0,drain," << thread_count << "," << backlog << "," << teardown_ms<ver_1_0::ThreadPool>(thread_count, backlog, submit_1_0, destroy) << std::endl;
+        std::cout << "ver_2_0,drain," << thread_count << "," << backlog << "," << teardown_ms<ver_2_0::ThreadPool>(thread_count, backlog, post, destroy) << std::endl;
+        std::cout << "ver_2_0,abort," << thread_count << "," << backlog << "," << teardown_ms<ver_2_0::ThreadPool>(thread_count, backlog, post, abort) << std::endl;
+        std::cout << "ver_2_0_numa,drain," << thread_count << "," << backlog << "," << teardown_ms<ver_2_0::NumaThreadPool>(thread_count, backlog, post, destroy) << std::endl;
+        std::cout << "ver_2_0_numa,abort," << thread_count << "," << backlog << "," << teardown_ms<ver_2_0::NumaThreadPool>(thread_count, backlog, post, abort) << std::endl;
+    }
+}
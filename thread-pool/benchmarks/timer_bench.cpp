@@ -0,0 +1,128 @@
+#include "thread_pool.hpp"
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 1. insert & cancel cost of TimerWheel vs. std::multimap (ordered timer queue) with n outstanding timers
+// 2. firing lateness of pool.submit_after() with n outstanding timers vs. tasks that sleep_for on a worker
+// usage: timer_bench [timers] [thread_count]
+
+using Clock = std::chrono::steady_clock;
+
+double ns_per_op(Clock::duration elapsed, size_t ops)
+{
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+}
+
+std::vector<uint64_t> random_expiries(size_t count)
+{
+    std::mt19937_64 gen {42};
+    std::uniform_int_distribution<uint64_t> distr(1, 60'000); // up to 1 minute at 1ms ticks
+
+    std::vector<uint64_t> expiries(count);
+    std::generate(expiries.begin(), expiries.end(), [&] { return distr(gen); });
+    return expiries;
+}
+
+void measure_wheel(const std::vector<uint64_t>& expiries)
+{
+    ver_2_0::TimerWheel<size_t> wheel;
+    std::vector<ver_2_0::TimerId> ids(expiries.size());
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < expiries.size(); ++i)
+        ids[i] = wheel.insert(expiries[i], i);
+    const auto insert_time = Clock::now() - start;
+
+    start = Clock::now();
+    for (size_t i = 0; i < ids.size(); i += 2)
+        wheel.cancel(ids[i]);
+    const auto cancel_time = Clock::now() - start;
+
+    size_t fired = 0;
+    start = Clock::now();
+    wheel.advance(60'001, [&](ver_2_0::TimerId, size_t&) -> std::optional<uint64_t> { ++fired; return std::nullopt; });
+    const auto expire_time = Clock::now() - start;
+
+    std::cout << "timer_wheel," << expiries.size() << "," << ns_per_op(insert_time, ids.size()) << ","
+              << ns_per_op(cancel_time, (ids.size() + 1) / 2) << "," << ns_per_op(expire_time, fired) << "\n";
+}
+
+void measure_multimap(const std::vector<uint64_t>& expiries)
+{
+    std::multimap<uint64_t, size_t> timers;
+    std::vector<std::multimap<uint64_t, size_t>::iterator> ids(expiries.size());
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < expiries.size(); ++i)
+        ids[i] = timers.emplace(expiries[i], i);
+    const auto insert_time = Clock::now() - start;
+
+    start = Clock::now();
+    for (size_t i = 0; i < ids.size(); i += 2)
+        timers.erase(ids[i]);
+    const auto cancel_time = Clock::now() - start;
+
+    const size_t fired = timers.size();
+    start = Clock::now();
+    while (!timers.empty())
+        timers.erase(timers.begin());
+    const auto expire_time = Clock::now() - start;
+
+    std::cout << "multimap," << expiries.size() << "," << ns_per_op(insert_time, ids.size()) << ","
+              << ns_per_op(cancel_time, (ids.size() + 1) / 2) << "," << ns_per_op(expire_time, fired) << "\n";
+}
+
+// lateness of a 50ms timer fired while `background` longer timers are outstanding
+void measure_lateness(const std::string& name, size_t thread_count, size_t background, bool sleeping_workers)
+{
+    ver_2_0::ThreadPool pool(thread_count);
+
+    std::vector<ver_2_0::TimerId> ids;
+    if (!sleeping_workers)
+    {
+        ids.reserve(background);
+        for (size_t i = 0; i < background; ++i)
+            ids.push_back(pool.post_after(std::chrono::seconds {10} + std::chrono::microseconds {i}, [] {}));
+    }
+    else
+    {
+        // the old way - each delayed task holds a worker hostage
+        for (size_t i = 0; i < thread_count; ++i)
+            pool.post([] { std::this_thread::sleep_for(std::chrono::milliseconds {200}); });
+    }
+
+    const auto delay = std::chrono::milliseconds {50};
+    const auto due = Clock::now() + delay;
+    const auto fired = pool.submit_after(delay, [] { return Clock::now(); }).get();
+
+    for (const auto& id : ids)
+        pool.cancel_timer(id);
+
+    std::cout << name << "," << thread_count << "," << background << ","
+              << std::chrono::duration<double, std::micro>(fired - due).count() << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t timers = argc > 1 ? std::stoul(argv[1]) : 100'000;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    const auto expiries = random_expiries(timers);
+
+    std::cout << "queue,timers,insert_ns,cancel_ns,expire_ns\n";
+    measure_multimap(expiries);
+    measure_wheel(expiries);
+
+    std::cout << "\nscenario,threads,outstanding_timers,lateness_us\n";
+    measure_lateness("submit_after", thread_count, timers, false);
+    measure_lateness("sleeping_workers", thread_count, 0, true);
+}
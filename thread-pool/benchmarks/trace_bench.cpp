@@ -0,0 +1,82 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+
+// cost of task tracing: empty tasks with tracing compiled out (trace_bench_off), compiled in but
+// disabled and enabled (trace_bench); trace_bench also writes a Chrome trace of an unbalanced
+// workload (a few long tasks among short ones) - open it in ui.perfetto.dev
+// usage: trace_bench [tasks] [thread_count] [trace_file]
+
+using Clock = std::chrono::steady_clock;
+
+void busy_for(std::chrono::microseconds duration)
+{
+    const auto until = Clock::now() + duration;
+    while (Clock::now() < until)
+    {
+    }
+}
+
+double empty_tasks_ms(ver_2_0::ThreadPool& pool, size_t tasks)
+{
+    std::latch done {static_cast<std::ptrdiff_t>(tasks)};
+
+    const auto start = Clock::now();
+    for (size_t i = 0; i < tasks; ++i)
+        pool.post([&done] { done.count_down(); });
+    done.wait();
+
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t tasks = argc > 1 ? std::stoul(argv[1]) : 500'000;
+    const size_t thread_count = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::string trace_file = argc > 3 ? argv[3] : "pool_trace.json";
+
+    std::cout << "build,tracing,threads,tasks,time_ms\n";
+
+    const char* build = ver_2_0::tracing_compiled_in ? "compiled_in" : "compiled_out";
+
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+        std::cout << build << ",disabled," << thread_count << "," << tasks << "," << empty_tasks_ms(pool, tasks) << std::endl;
+    }
+
+    if (!ver_2_0::tracing_compiled_in)
+        return 0;
+
+    {
+        ver_2_0::ThreadPool pool(thread_count);
+        pool.enable_tracing(tasks);
+        std::cout << build << ",enabled," << thread_count << "," << tasks << "," << empty_tasks_ms(pool, tasks) << std::endl;
+    }
+
+    ver_2_0::ThreadPool pool(thread_count);
+    pool.enable_tracing();
+
+    constexpr size_t traced_tasks = 2'000;
+    std::latch done {traced_tasks};
+    for (size_t i = 0; i < traced_tasks; ++i)
+    {
+        pool.post([&done, i] {
+            busy_for(std::chrono::microseconds {i % 100 == 0 ? 2'000 : 20});
+            done.count_down();
+        });
+
+        if (i % 500 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds {2}); // idle gaps
+    }
+    done.wait();
+
+    std::ofstream out {trace_file};
+    pool.write_trace(out);
+    std::cerr << "trace of " << traced_tasks << " tasks written to " << trace_file << " (" << pool.dropped_trace_events() << " events dropped)\n";
+}
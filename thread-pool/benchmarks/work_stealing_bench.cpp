@@ -0,0 +1,90 @@
+#include "thread_pool.hpp"
+#include "work_stealing_thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// usage: work_stealing_bench [task_count] [max_threads]
+
+template <typename TPool>
+double flat_submit(size_t thread_count, size_t task_count)
+{
+    TPool pool(thread_count);
+    std::atomic<size_t> counter {0};
+    std::promise<void> done;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < task_count; ++i)
+        pool.submit([&] {
+            if (counter.fetch_add(1) + 1 == task_count)
+                done.set_value();
+        });
+
+    done.get_future().wait();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return task_count / std::chrono::duration<double>(end - start).count();
+}
+
+template <typename TPool>
+void spawn_tree(TPool& pool, size_t depth, std::atomic<size_t>& counter, size_t total, std::promise<void>& done)
+{
+    if (depth > 0)
+    {
+        pool.submit([&pool, depth, &counter, total, &done] { spawn_tree(pool, depth - 1, counter, total, done); });
+        pool.submit([&pool, depth, &counter, total, &done] { spawn_tree(pool, depth - 1, counter, total, done); });
+    }
+
+    if (counter.fetch_add(1) + 1 == total)
+        done.set_value();
+}
+
+template <typename TPool>
+double recursive_spawn(size_t thread_count, size_t task_count)
+{
+    size_t depth = 0;
+    while ((size_t(2) << (depth + 1)) - 1 <= task_count)
+        ++depth;
+    const size_t total = (size_t(2) << depth) - 1;
+
+    TPool pool(thread_count);
+    std::atomic<size_t> counter {0};
+    std::promise<void> done;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    pool.submit([&] { spawn_tree(pool, depth, counter, total, done); });
+    done.get_future().wait();
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    return total / std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t task_count = argc > 1 ? std::stoul(argv[1]) : 200'000;
+    const size_t max_threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "scenario,threads,ver_2_0_tasks_per_sec,ver_3_0_tasks_per_sec\n";
+
+    for (size_t threads = 1; threads <= max_threads; ++threads)
+    {
+        std::cout << "flat_submit," << threads << ","
+                  << flat_submit<ver_2_0::ThreadPool>(threads, task_count) << ","
+                  << flat_submit<ver_3_0::ThreadPool>(threads, task_count) << std::endl;
+    }
+
+    for (size_t threads = 1; threads <= max_threads; ++threads)
+    {
+        std::cout << "recursive_spawn," << threads << ","
+                  << recursive_spawn<ver_2_0::ThreadPool>(threads, task_count) << ","
+                  << recursive_spawn<ver_3_0::ThreadPool>(threads, task_count) << std::endl;
+    }
+}
@@ -0,0 +1,341 @@
+#ifndef CORO_TASK_HPP
+#define CORO_TASK_HPP
+
+#include "executor.hpp"
+#include "pool_future.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////
+// C++20 coroutines on top of executors (ThreadPool, ElasticThreadPool, ...)
+//  - CoroTask<T> - lazy coroutine: starts when awaited, resumes its awaiter
+//    by symmetric transfer when done
+//  - co_await executor.schedule() - continues on a worker of the executor
+//  - co_await future - suspends until a pool future is ready and resumes
+//    on the executor of the future, no thread is blocked meanwhile
+//  - spawn(executor, task) - starts a task on the executor and returns
+//    a Future<T> of its result; throws if the executor refuses it
+//  - a coroutine whose resumption is dropped by the executor (shutdown_now(),
+//    drop_oldest, ...) is destroyed together with the chain of coroutines awaiting
+//    it - the future returned by spawn() reports broken_promise
+namespace ver_2_0
+{
+    template <typename T = void>
+    class CoroTask;
+
+    namespace detail
+    {
+        class CoroPromiseBase
+        {
+        public:
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            struct FinalAwaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                template <typename TPromise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> coroutine) noexcept
+                {
+                    return coroutine.promise().continuation_;
+                }
+
+                void await_resume() noexcept
+                {
+                }
+            };
+
+            FinalAwaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void unhandled_exception()
+            {
+                exception_ = std::current_exception();
+            }
+
+            void set_continuation(std::coroutine_handle<> continuation, std::coroutine_handle<> root)
+            {
+                continuation_ = continuation;
+                root_ = root;
+            }
+
+            // the frame owning this coroutine - see detail::owning_frame()
+            std::coroutine_handle<> root() const noexcept
+            {
+                return root_;
+            }
+
+        protected:
+            std::coroutine_handle<> continuation_ = std::noop_coroutine();
+            std::coroutine_handle<> root_;
+            std::exception_ptr exception_;
+
+            void rethrow_if_exception()
+            {
+                if (exception_)
+                    std::rethrow_exception(exception_);
+            }
+        };
+
+        template <typename T>
+        class CoroPromise : public CoroPromiseBase
+        {
+        public:
+            template <typename U>
+            void return_value(U&& value)
+            {
+                value_.emplace(std::forward<U>(value));
+            }
+
+            T result()
+            {
+                rethrow_if_exception();
+                return std::move(*value_);
+            }
+
+        private:
+            std::optional<T> value_;
+        };
+
+        template <>
+        class CoroPromise<void> : public CoroPromiseBase
+        {
+        public:
+            void return_void()
+            {
+            }
+
+            void result()
+            {
+                rethrow_if_exception();
+            }
+        };
+
+        // coroutine started by resuming its handle - destroys itself when finished
+        struct DetachedCoroutine
+        {
+            struct promise_type
+            {
+                DetachedCoroutine get_return_object() noexcept
+                {
+                    return {std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::coroutine_handle<> root() noexcept
+                {
+                    return std::coroutine_handle<promise_type>::from_promise(*this);
+                }
+
+                std::suspend_always initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() noexcept
+                {
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+            std::coroutine_handle<promise_type> coroutine;
+        };
+    }
+
+    template <typename T>
+    class CoroTask
+    {
+    public:
+        struct promise_type : detail::CoroPromise<T>
+        {
+            CoroTask get_return_object() noexcept
+            {
+                return CoroTask {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+        };
+
+        CoroTask() = default;
+
+        CoroTask(const CoroTask&) = delete;
+        CoroTask& operator=(const CoroTask&) = delete;
+
+        CoroTask(CoroTask&& other) noexcept
+            : coroutine_ {std::exchange(other.coroutine_, nullptr)}
+        {
+        }
+
+        CoroTask& operator=(CoroTask&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coroutine_)
+                    coroutine_.destroy();
+                coroutine_ = std::exchange(other.coroutine_, nullptr);
+            }
+
+            return *this;
+        }
+
+        ~CoroTask()
+        {
+            if (coroutine_)
+                coroutine_.destroy();
+        }
+
+        bool valid() const noexcept
+        {
+            return static_cast<bool>(coroutine_);
+        }
+
+        class Awaiter
+        {
+        public:
+            explicit Awaiter(std::coroutine_handle<promise_type> coroutine)
+                : coroutine_ {coroutine}
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return coroutine_.done();
+            }
+
+            template <typename TPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> awaiting) noexcept
+            {
+                coroutine_.promise().set_continuation(awaiting, detail::owning_frame(awaiting));
+                return coroutine_;
+            }
+
+            T await_resume()
+            {
+                return coroutine_.promise().result();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> coroutine_;
+        };
+
+        Awaiter operator co_await() && noexcept
+        {
+            return Awaiter {coroutine_};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> coroutine_;
+
+        explicit CoroTask(std::coroutine_handle<promise_type> coroutine)
+            : coroutine_ {coroutine}
+        {
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // co_await on a pool future - the future is consumed like by get()
+    template <typename T>
+    class FutureAwaiter
+    {
+    public:
+        explicit FutureAwaiter(Future<T> future)
+            : future_ {std::move(future)}
+        {
+        }
+
+        bool await_ready() const
+        {
+            return future_.is_ready();
+        }
+
+        template <typename TPromise>
+        void await_suspend(std::coroutine_handle<TPromise> coroutine)
+        {
+            detail::SharedState<T>* state = detail::FutureAccess::state(future_);
+            state->set_continuation(detail::ResumeTask {coroutine, detail::owning_frame(coroutine)}, state->executor());
+        }
+
+        T await_resume()
+        {
+            return future_.get();
+        }
+
+    private:
+        Future<T> future_;
+    };
+
+    template <typename T>
+    FutureAwaiter<T> operator co_await(Future<T>&& future)
+    {
+        return FutureAwaiter<T> {std::move(future)};
+    }
+
+    template <typename T>
+    FutureAwaiter<T> operator co_await(Future<T>& future)
+    {
+        return FutureAwaiter<T> {std::move(future)};
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        DetachedCoroutine run_detached(CoroTask<T> task, Promise<T> promise)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await std::move(task);
+                    promise.set_value();
+                }
+                else
+                    promise.set_value(co_await std::move(task));
+            }
+            catch (...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    template <typename T>
+    Future<T> spawn(Executor& executor, CoroTask<T> task)
+    {
+        Promise<T> promise(nullptr, &executor);
+        Future<T> f_result = promise.get_future();
+
+        std::coroutine_handle<> coroutine = detail::run_detached(std::move(task), std::move(promise)).coroutine;
+
+        try
+        {
+            executor.post(detail::ResumeTask {coroutine, coroutine});
+        }
+        catch (...)
+        {
+            coroutine.destroy(); // never started - the ResumeTask left it to us
+            throw;
+        }
+
+        return f_result;
+    }
+}
+
+#endif // CORO_TASK_HPP
@@ -0,0 +1,153 @@
+#ifndef CPU_TOPOLOGY_HPP
+#define CPU_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+// NUMA nodes and their cpus
+//  - from_sysfs() reads /sys/devices/system/node (falls back to a single node)
+//  - from_description("0-3,8-11;4-7,12-15") - cpu lists of nodes separated by ';'
+class CpuTopology
+{
+public:
+    using CpuSet = std::vector<int>;
+
+    explicit CpuTopology(std::vector<CpuSet> nodes)
+        : nodes_ {std::move(nodes)}
+    {
+        if (nodes_.empty() || std::any_of(nodes_.begin(), nodes_.end(), [](const CpuSet& cpus) { return cpus.empty(); }))
+            throw std::invalid_argument("Every NUMA node needs at least one cpu");
+
+        for (size_t node = 0; node < nodes_.size(); ++node)
+            for (int cpu : nodes_[node])
+            {
+                if (static_cast<size_t>(cpu) >= node_of_cpu_.size())
+                    node_of_cpu_.resize(cpu + 1, 0);
+                node_of_cpu_[cpu] = node;
+            }
+    }
+
+    static CpuTopology single_node()
+    {
+        CpuSet cpus(std::max(1u, std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < cpus.size(); ++i)
+            cpus[i] = static_cast<int>(i);
+
+        return CpuTopology({cpus});
+    }
+
+    static CpuTopology from_description(const std::string& description)
+    {
+        std::vector<CpuSet> nodes;
+        std::istringstream in {description};
+
+        for (std::string node_cpus; std::getline(in, node_cpus, ';');)
+            nodes.push_back(parse_cpu_list(node_cpus));
+
+        return CpuTopology(std::move(nodes));
+    }
+
+    static CpuTopology from_sysfs(const std::string& root = "/sys/devices/system/node")
+    {
+        std::vector<CpuSet> nodes;
+
+        for (size_t node = 0;; ++node)
+        {
+            std::ifstream in {root + "/node" + std::to_string(node) + "/cpulist"};
+            std::string cpu_list;
+            if (!in || !std::getline(in, cpu_list))
+                break;
+
+            CpuSet cpus = parse_cpu_list(cpu_list);
+            if (!cpus.empty()) // memory-only nodes have no cpus
+                nodes.push_back(std::move(cpus));
+        }
+
+        if (nodes.empty())
+            return single_node();
+
+        return CpuTopology(std::move(nodes));
+    }
+
+    // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+    static CpuSet parse_cpu_list(const std::string& cpu_list)
+    {
+        CpuSet cpus;
+        std::istringstream in {cpu_list};
+
+        for (std::string range; std::getline(in, range, ',');)
+        {
+            if (range.find_first_not_of(" \t\n") == std::string::npos)
+                continue;
+
+            const auto dash = range.find('-');
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        return cpus;
+    }
+
+    size_t node_count() const
+    {
+        return nodes_.size();
+    }
+
+    const CpuSet& cpus(size_t node) const
+    {
+        return nodes_.at(node);
+    }
+
+    size_t node_of_cpu(int cpu) const
+    {
+        return (cpu >= 0 && static_cast<size_t>(cpu) < node_of_cpu_.size()) ? node_of_cpu_[cpu] : 0;
+    }
+
+    // node of the cpu the calling thread is running on right now
+    size_t current_node() const
+    {
+#ifdef __linux__
+        return node_of_cpu(sched_getcpu());
+#else
+        return 0;
+#endif
+    }
+
+private:
+    std::vector<CpuSet> nodes_;
+    std::vector<size_t> node_of_cpu_;
+};
+
+// restricts a thread to the given cpus - returns false if not supported or failed
+inline bool pin_thread(std::thread::native_handle_type handle, const CpuTopology::CpuSet& cpus)
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : cpus)
+        CPU_SET(cpu, &cpu_set);
+
+    return pthread_setaffinity_np(handle, sizeof(cpu_set), &cpu_set) == 0;
+#else
+    (void)handle;
+    (void)cpus;
+    return false;
+#endif
+}
+
+#endif // CPU_TOPOLOGY_HPP
@@ -0,0 +1,248 @@
+#ifndef ELASTIC_THREAD_POOL_HPP
+#define ELASTIC_THREAD_POOL_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ver_2_0
+{
+    struct ElasticOptions
+    {
+        size_t min_threads = 1;
+        size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::chrono::milliseconds idle_timeout {1000};       // idle worker above min_threads retires after that
+        size_t spawn_queue_depth = 1;                         // spawn when no worker is idle and so many tasks wait
+        std::chrono::microseconds spawn_wait_threshold {500}; // spawn when a task waited longer than that
+    };
+
+    struct ElasticPoolStats
+    {
+        size_t threads;
+        size_t idle_threads;
+        size_t peak_threads;
+        size_t spawned_threads;
+        size_t retired_threads;
+        size_t queue_depth;
+        size_t executed_tasks;
+        std::chrono::nanoseconds avg_queue_delay;
+        std::chrono::nanoseconds max_queue_delay;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // thread pool that grows from min_threads up to max_threads under load
+    // and shrinks back when workers stay idle
+    //  - only idle workers retire, running tasks are never interrupted
+    //  - stats() can be called from any thread
+    class ElasticThreadPool : public Executor
+    {
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        explicit ElasticThreadPool(ElasticOptions options = {})
+            : options_ {options}
+        {
+            if (options_.min_threads == 0 || options_.max_threads < options_.min_threads)
+                throw std::invalid_argument("Invalid thread limits");
+
+            std::lock_guard<std::mutex> lk {mtx_threads_};
+            for (size_t i = 0; i < options_.min_threads; ++i)
+                spawn_worker();
+        }
+
+        ElasticThreadPool(const ElasticThreadPool&) = delete;
+        ElasticThreadPool& operator=(const ElasticThreadPool&) = delete;
+
+        ~ElasticThreadPool()
+        {
+            std::vector<std::thread> threads;
+
+            {
+                std::lock_guard<std::mutex> lk {mtx_threads_};
+                stop_ = true; // no spawning & no retiring from now on
+
+                for (size_t i = 0; i < workers_.size(); ++i)
+                {
+                    queue_depth_.fetch_add(1, std::memory_order_relaxed);
+                    tasks_.push(QueuedTask {}); // empty task stops a single worker
+                }
+
+                for (auto& [id, thread] : workers_)
+                    threads.push_back(std::move(thread));
+                for (auto& thread : retired_)
+                    threads.push_back(std::move(thread));
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        void post(Task task) override
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            push(std::move(task));
+        }
+
+        template <typename F>
+        auto submit(F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = detail::package_task(slab_.get(), this, std::forward<F>(f));
+            push(std::move(task));
+            return std::move(f_result);
+        }
+
+        size_t size() const
+        {
+            return thread_count_.load(std::memory_order_relaxed);
+        }
+
+        ElasticPoolStats stats() const
+        {
+            const size_t executed = executed_tasks_.load(std::memory_order_relaxed);
+            const auto total_delay = total_queue_delay_ns_.load(std::memory_order_relaxed);
+
+            return ElasticPoolStats {
+                thread_count_.load(std::memory_order_relaxed),
+                idle_count_.load(std::memory_order_relaxed),
+                peak_threads_.load(std::memory_order_relaxed),
+                spawned_threads_.load(std::memory_order_relaxed),
+                retired_threads_.load(std::memory_order_relaxed),
+                queue_depth_.load(std::memory_order_relaxed),
+                executed,
+                std::chrono::nanoseconds(executed ? total_delay / executed : 0),
+                std::chrono::nanoseconds(max_queue_delay_ns_.load(std::memory_order_relaxed))};
+        }
+
+    private:
+        const ElasticOptions options_;
+        detail::SharedStateSlab::OwnerPtr slab_ = detail::SharedStateSlab::create();
+        ThreadSafeQueue<QueuedTask> tasks_;
+
+        std::mutex mtx_threads_;
+        std::map<size_t, std::thread> workers_;
+        std::vector<std::thread> retired_; // finished workers - joined lazily
+        size_t next_worker_id_ = 0;
+        bool stop_ = false;
+
+        std::atomic<size_t> thread_count_ {0};
+        std::atomic<size_t> idle_count_ {0};
+        std::atomic<size_t> queue_depth_ {0};
+        std::atomic<size_t> peak_threads_ {0};
+        std::atomic<size_t> spawned_threads_ {0};
+        std::atomic<size_t> retired_threads_ {0};
+        std::atomic<size_t> executed_tasks_ {0};
+        std::atomic<int64_t> total_queue_delay_ns_ {0};
+        std::atomic<int64_t> max_queue_delay_ns_ {0};
+
+        void push(Task task)
+        {
+            const size_t depth = queue_depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+            tasks_.push(QueuedTask {std::move(task), Clock::now()});
+
+            if (idle_count_.load(std::memory_order_relaxed) == 0 && depth >= options_.spawn_queue_depth)
+                try_grow();
+        }
+
+        void try_grow()
+        {
+            if (thread_count_.load(std::memory_order_relaxed) >= options_.max_threads)
+                return;
+
+            std::lock_guard<std::mutex> lk {mtx_threads_};
+            if (!stop_ && thread_count_.load(std::memory_order_relaxed) < options_.max_threads)
+                spawn_worker();
+        }
+
+        // precondition: mtx_threads_ is locked
+        void spawn_worker()
+        {
+            for (auto& thread : retired_)
+                thread.join();
+            retired_.clear();
+
+            const size_t id = next_worker_id_++;
+            workers_.emplace(id, std::thread([this, id] { run(id); }));
+
+            const size_t count = thread_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+            spawned_threads_.fetch_add(1, std::memory_order_relaxed);
+
+            size_t peak = peak_threads_.load(std::memory_order_relaxed);
+            while (count > peak && !peak_threads_.compare_exchange_weak(peak, count, std::memory_order_relaxed))
+                ;
+        }
+
+        bool try_retire(size_t id)
+        {
+            std::lock_guard<std::mutex> lk {mtx_threads_};
+
+            if (stop_ || thread_count_.load(std::memory_order_relaxed) <= options_.min_threads)
+                return false;
+
+            auto it = workers_.find(id);
+            retired_.push_back(std::move(it->second));
+            workers_.erase(it);
+
+            thread_count_.fetch_sub(1, std::memory_order_relaxed);
+            retired_threads_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        void record_queue_delay(Clock::duration delay)
+        {
+            const int64_t delay_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+
+            executed_tasks_.fetch_add(1, std::memory_order_relaxed);
+            total_queue_delay_ns_.fetch_add(delay_ns, std::memory_order_relaxed);
+
+            int64_t max_delay = max_queue_delay_ns_.load(std::memory_order_relaxed);
+            while (delay_ns > max_delay && !max_queue_delay_ns_.compare_exchange_weak(max_delay, delay_ns, std::memory_order_relaxed))
+                ;
+        }
+
+        void run(size_t id)
+        {
+            while (true)
+            {
+                QueuedTask item;
+
+                idle_count_.fetch_add(1, std::memory_order_relaxed);
+                const bool has_task = tasks_.pop_for(item, options_.idle_timeout);
+                idle_count_.fetch_sub(1, std::memory_order_relaxed);
+
+                if (!has_task)
+                {
+                    if (try_retire(id))
+                        return;
+                    continue;
+                }
+
+                queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+
+                if (!item.task)
+                    return;
+
+                const auto delay = Clock::now() - item.enqueued_at;
+                record_queue_delay(delay);
+
+                // the queue is not keeping up - add a worker
+                if (delay > options_.spawn_wait_threshold && queue_depth_.load(std::memory_order_relaxed) > 0)
+                    try_grow();
+
+                item.task();
+            }
+        }
+    };
+}
+
+#endif // ELASTIC_THREAD_POOL_HPP
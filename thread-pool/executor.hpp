@@ -0,0 +1,160 @@
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+
+#include "unique_function.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// move-only task - callables up to 56 bytes are stored without heap allocation
+using Task = ext::unique_function<void()>;
+
+namespace ver_2_0
+{
+    namespace detail
+    {
+        // runs f - or on_drop() if it is destroyed without having run (discarded by
+        // shutdown_now(), dropped by a bounded queue, left over after the workers exited)
+        template <typename F, typename OnDrop>
+        class DroppableTask
+        {
+        public:
+            DroppableTask(F f, OnDrop on_drop)
+                : f_ {std::move(f)}
+                , on_drop_ {std::move(on_drop)}
+            {
+            }
+
+            DroppableTask(DroppableTask&& other) noexcept
+                : f_ {std::move(other.f_)}
+                , on_drop_ {std::move(other.on_drop_)}
+                , armed_ {std::exchange(other.armed_, false)}
+            {
+            }
+
+            DroppableTask& operator=(DroppableTask&&) = delete;
+
+            ~DroppableTask()
+            {
+                if (armed_)
+                    on_drop_();
+            }
+
+            void operator()()
+            {
+                armed_ = false;
+                f_();
+            }
+
+        private:
+            F f_;
+            OnDrop on_drop_;
+            bool armed_ = true;
+        };
+
+        // the frame whose destruction destroys a suspended coroutine - the coroutine itself
+        // unless its promise names the root of the chain it belongs to (CoroTask, spawn())
+        template <typename TPromise>
+        std::coroutine_handle<> owning_frame(std::coroutine_handle<TPromise> coroutine) noexcept
+        {
+            if constexpr (requires { coroutine.promise().root(); })
+                return coroutine.promise().root();
+            else
+                return coroutine;
+        }
+
+        // resumes a suspended coroutine - destroys its owning frame if it is dropped without
+        // having run; not while an exception thrown by post() unwinds it - that exception
+        // is delivered to the coroutine instead
+        class ResumeTask
+        {
+        public:
+            ResumeTask(std::coroutine_handle<> coroutine, std::coroutine_handle<> frame) noexcept
+                : coroutine_ {coroutine}
+                , frame_ {frame}
+                , uncaught_ {std::uncaught_exceptions()}
+            {
+            }
+
+            ResumeTask(ResumeTask&& other) noexcept
+                : coroutine_ {std::exchange(other.coroutine_, nullptr)}
+                , frame_ {other.frame_}
+                , uncaught_ {other.uncaught_}
+            {
+            }
+
+            ResumeTask& operator=(ResumeTask&&) = delete;
+
+            ~ResumeTask()
+            {
+                if (coroutine_ && std::uncaught_exceptions() <= uncaught_)
+                    frame_.destroy();
+            }
+
+            void operator()()
+            {
+                std::exchange(coroutine_, nullptr).resume();
+            }
+
+        private:
+            std::coroutine_handle<> coroutine_;
+            std::coroutine_handle<> frame_;
+            int uncaught_;
+        };
+    }
+
+    // anything that runs posted tasks - thread pools, strands, ...
+    class Executor
+    {
+    public:
+        virtual ~Executor() = default;
+
+        virtual void post(Task task) = 0;
+
+        // for tasks the library schedules on behalf of work already accepted (continuations,
+        // timer hand-offs, strand drains, task graph nodes, parallel_for splits) - must neither
+        // fail nor block because of a full queue, so executors with a bounded queue ignore
+        // its capacity here; the default is post()
+        virtual void post_internal(Task task)
+        {
+            post(std::move(task));
+        }
+
+        // co_await executor.schedule() - the coroutine continues on the executor
+        class ScheduleAwaiter
+        {
+        public:
+            explicit ScheduleAwaiter(Executor& executor)
+                : executor_ {executor}
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            // an exception thrown by post() (e.g. QueueFullError) is rethrown by the co_await
+            template <typename TPromise>
+            void await_suspend(std::coroutine_handle<TPromise> coroutine)
+            {
+                executor_.post(detail::ResumeTask {coroutine, detail::owning_frame(coroutine)});
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+        private:
+            Executor& executor_;
+        };
+
+        ScheduleAwaiter schedule()
+        {
+            return ScheduleAwaiter {*this};
+        }
+    };
+}
+
+#endif // EXECUTOR_HPP
@@ -0,0 +1,36 @@
+#ifndef IDLE_POLICY_HPP
+#define IDLE_POLICY_HPP
+
+#include <cstddef>
+#include <limits>
+
+namespace ver_2_0
+{
+    //////////////////////////////////////////////////////////////////////
+    // what an idle pool worker does before it parks on the queue
+    //  - spin_count polls of the queue with a cpu pause in between, then
+    //    yield_count polls with std::this_thread::yield, then park
+    //  - at most max_spinners workers spin/yield at the same time (hot workers),
+    //    the others park immediately
+    //  - spinning trades cpu time for wake-up latency: a task pushed while a
+    //    worker spins is picked up without a futex wake & context switch
+    struct IdlePolicy
+    {
+        size_t spin_count = 0;
+        size_t yield_count = 0;
+        size_t max_spinners = std::numeric_limits<size_t>::max();
+
+        // default - workers park at once
+        static constexpr IdlePolicy park()
+        {
+            return IdlePolicy {};
+        }
+
+        static constexpr IdlePolicy spin_then_park(size_t spin_count = 4'000, size_t yield_count = 64, size_t max_spinners = 1)
+        {
+            return IdlePolicy {spin_count, yield_count, max_spinners};
+        }
+    };
+}
+
+#endif // IDLE_POLICY_HPP
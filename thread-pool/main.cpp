@@ -1,4 +1,4 @@
-#include "thread_safe_queue.hpp"
+#include "thread_pool.hpp"
 
 #include <cassert>
 #include <chrono>
@@ -12,117 +12,6 @@
 
 using namespace std::literals;
 
-using Task = std::function<void()>;
-//using Task = Folly::function<void()>;
-
-namespace ver_1_0
-{
-    class ThreadPool
-    {
-    public:
-        ThreadPool(size_t size)
-            : threads_(size)
-        {
-            for (auto& thread : threads_)
-                thread = std::thread([this]
-                    { run(); });
-        }
-
-        ThreadPool(const ThreadPool&) = delete;
-        ThreadPool& operator=(const ThreadPool&) = delete;
-
-        ~ThreadPool()
-        {
-            for (size_t i = 0; i < threads_.size(); ++i)
-                tasks_.push(STOP);
-
-            for (auto& thread : threads_)
-                thread.join();
-        }
-
-        void submit(Task task)
-        {
-            if (!task)
-                throw std::invalid_argument("Empty task not supported");
-
-            tasks_.push(task);
-        }
-
-    private:
-        std::vector<std::thread> threads_;
-        ThreadSafeQueue<Task> tasks_;
-        const Task STOP;
-
-        void run()
-        {
-            while (true)
-            {
-                Task task;
-                tasks_.pop(task);
-
-                if (!task)
-                    break;
-
-                task();
-            }
-        }
-    };
-}
-
-namespace ver_2_0
-{
-    class ThreadPool
-    {
-    public:
-        ThreadPool(size_t size)
-            : threads_(size)
-        {
-            for (auto& thread : threads_)
-                thread = std::thread([this]
-                    { run(); });
-        }
-
-        ThreadPool(const ThreadPool&) = delete;
-        ThreadPool& operator=(const ThreadPool&) = delete;
-
-        ~ThreadPool()
-        {
-            for (size_t i = 0; i < threads_.size(); ++i)
-                tasks_.push([this]
-                    { stop_ = true; });
-
-            for (auto& thread : threads_)
-                thread.join();
-        }
-
-
-        template <typename F>
-        auto submit(F&& f) -> std::future<decltype(f())>
-        {
-            using ResultT = decltype(f());
-            auto pt = std::make_shared<std::packaged_task<ResultT()>>(std::forward<F>(f));
-            std::future<ResultT> f_result = pt->get_future();
-            tasks_.push([pt] { (*pt)(); });
-            return f_result;
-        }
-
-    private:
-        std::vector<std::thread> threads_;
-        ThreadSafeQueue<Task> tasks_;
-        std::atomic<bool> stop_ {false};
-
-        void run()
-        {
-            while (!stop_)
-            {
-                Task task;
-                tasks_.pop(task);
-                task();
-            }
-        }
-    };
-}
-
 void background_work(size_t id, const std::string& text, std::chrono::milliseconds delay)
 {
     std::cout << "bw#" << id << " has started..." << std::endl;
@@ -165,26 +54,38 @@ int main()
             { background_work(i, text, 250ms); });
     }
 
-    std::vector<std::pair<int, std::future<int>>> f_squares;
+    std::vector<int> args;
+    std::vector<ver_2_0::Future<int>> f_squares;
 
     for(int i = 1; i < 100; ++i)
     {
-        f_squares.emplace_back(i, thd_pool.submit([i] { return calculate_square(i); }));
+        args.push_back(i);
+        f_squares.push_back(thd_pool.submit([i] { return calculate_square(i); }));
     }
 
-    for(auto& fs : f_squares)
+    // results are printed in completion order - a slow task does not hold back the ones already done
+    ver_2_0::CompletionQueue completed_squares {std::move(f_squares)};
+    while (!completed_squares.empty())
     {
-        std::cout << fs.first << " - ";
+        auto [index, f_square] = completed_squares.next();
+
+        std::cout << args[index] << " - ";
         try
         {
-            int result = fs.second.get();
+            int result = f_square.get();
             std::cout << result << "\n";
         }
         catch(const std::exception& e)
         {
             std::cout << e.what() << '\n';
-        }        
+        }
     }
 
+    // continuations run on the pool - the main thread blocks only for the final result
+    auto f_description = thd_pool.submit([] { return calculate_square(7); })
+                             .then([](int square) { return square + 1; })
+                             .then([](int value) { return "7 * 7 + 1 = " + std::to_string(value); });
+    std::cout << f_description.get() << std::endl;
+
     std::cout << "Main thread ends..." << std::endl;
 }
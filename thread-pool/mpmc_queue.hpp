@@ -0,0 +1,244 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////
+// Lock-free bounded MPMC queue (D. Vyukov's design)
+//  - fixed-capacity ring buffer allocated once in the constructor
+//  - every slot has a sequence number that tells producers & consumers
+//    whether it is free or holds an item for the current lap
+//  - push on a full queue spins/yields until a consumer makes room - a consumer
+//    must not push into its own full queue (use try_push), pop on an empty queue
+//    spins and then parks on a condition variable; the mutex is touched only when parking
+template <typename T>
+class BoundedMpmcQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow move constructible");
+
+    static constexpr size_t cache_line_size = 64;
+    static constexpr int spin_count = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* item() noexcept
+        {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> buffer_;
+
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_ {0};
+    alignas(cache_line_size) std::atomic<size_t> dequeue_pos_ {0};
+
+    alignas(cache_line_size) std::atomic<size_t> waiters_ {0};
+    std::mutex mtx_;
+    std::condition_variable cv_not_empty_;
+
+    static size_t round_up_to_power_of_2(size_t n)
+    {
+        size_t result = 2;
+        while (result < n)
+            result <<= 1;
+        return result;
+    }
+
+    void notify_waiters(bool all)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiters_.load(std::memory_order_relaxed) > 0)
+        {
+            { std::lock_guard<std::mutex> lk {mtx_}; }
+
+            if (all)
+                cv_not_empty_.notify_all();
+            else
+                cv_not_empty_.notify_one();
+        }
+    }
+
+    template <typename U>
+    void push_without_notify(U&& item)
+    {
+        for (int i = 0; !try_emplace(std::forward<U>(item)); ++i)
+        {
+            if (i >= spin_count)
+            {
+                notify_waiters(true); // items pushed without notification may fill the queue
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    explicit BoundedMpmcQueue(size_t capacity = 1024)
+        : mask_ {round_up_to_power_of_2(capacity) - 1}
+        , buffer_ {new Cell[mask_ + 1]}
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    ~BoundedMpmcQueue()
+    {
+        T item;
+        while (try_pop(item))
+            ;
+    }
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    bool empty() const
+    {
+        return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_.load(std::memory_order_acquire);
+    }
+
+    template <typename... TArgs>
+    bool try_emplace(TArgs&&... args)
+    {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &buffer_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // full
+            else
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+
+        new (cell->storage) T(std::forward<TArgs>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool try_push(const T& item)
+    {
+        T copy(item);
+        return try_emplace(std::move(copy));
+    }
+
+    bool try_push(T&& item)
+    {
+        return try_emplace(std::move(item));
+    }
+
+    void push(const T& item)
+    {
+        T copy(item);
+        push(std::move(copy));
+    }
+
+    void push(T&& item)
+    {
+        push_without_notify(std::move(item));
+        notify_waiters(false);
+    }
+
+    void push(std::initializer_list<T> lst)
+    {
+        for (const auto& item : lst)
+            push_without_notify(T(item));
+
+        notify_waiters(true);
+    }
+
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            push_without_notify(std::move(*first));
+
+        notify_waiters(true);
+    }
+
+    // pushes the longest prefix of [first, last) that fits - returns its end
+    template <typename InputIt>
+    InputIt try_push_range(InputIt first, InputIt last)
+    {
+        for (; first != last && try_emplace(std::move(*first)); ++first)
+            ;
+
+        notify_waiters(true);
+        return first;
+    }
+
+    bool try_pop(T& item)
+    {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &buffer_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // empty
+            else
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+
+        T* stored = cell->item();
+        item = std::move(*stored);
+        stored->~T();
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    void pop(T& item)
+    {
+        for (int i = 0; i < spin_count; ++i)
+        {
+            if (try_pop(item))
+                return;
+        }
+
+        std::unique_lock<std::mutex> lk {mtx_};
+        waiters_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv_not_empty_.wait(lk, [this, &item] { return try_pop(item); });
+        waiters_.fetch_sub(1);
+    }
+};
+
+#endif // MPMC_QUEUE_HPP
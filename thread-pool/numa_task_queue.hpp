@@ -0,0 +1,188 @@
+#ifndef NUMA_TASK_QUEUE_HPP
+#define NUMA_TASK_QUEUE_HPP
+
+#include "cpu_topology.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// task queue with one sub-queue per NUMA node
+//  - push goes to the sub-queue of the node the pushing thread runs on
+//  - a worker bound to node N pops from sub-queue N first and steals
+//    from other nodes only when its own sub-queue is empty
+//  - worker i is bound to node i % node_count and, if pin_workers is set,
+//    restricted to the cpus of that node
+template <typename T>
+class NumaTaskQueue
+{
+public:
+    static constexpr bool is_fifo = false;
+
+    explicit NumaTaskQueue(CpuTopology topology = CpuTopology::from_sysfs(), bool pin_workers = true)
+        : topology_ {std::move(topology)}
+        , pin_workers_ {pin_workers}
+        , lanes_(topology_.node_count())
+    {
+        for (auto& lane : lanes_)
+            lane = std::make_unique<Lane>();
+    }
+
+    NumaTaskQueue(const NumaTaskQueue&) = delete;
+    NumaTaskQueue& operator=(const NumaTaskQueue&) = delete;
+
+    const CpuTopology& topology() const
+    {
+        return topology_;
+    }
+
+    // cpus that worker index should be pinned to - empty if pinning is disabled
+    CpuTopology::CpuSet worker_cpus(size_t index) const
+    {
+        if (!pin_workers_)
+            return {};
+
+        return topology_.cpus(index % topology_.node_count());
+    }
+
+    // called by the worker thread itself before it starts popping
+    void bind_worker(size_t index)
+    {
+        current_queue_ = this;
+        current_node_ = index % topology_.node_count();
+    }
+
+    bool empty() const
+    {
+        return pending_.load() == 0;
+    }
+
+    size_t size() const
+    {
+        return pending_.load();
+    }
+
+    void push(const T& item)
+    {
+        push(T(item));
+    }
+
+    void push(T&& item)
+    {
+        {
+            Lane& lane = *lanes_[submitter_node()];
+            std::lock_guard<std::mutex> lk {lane.mtx};
+            lane.items.push_back(std::move(item));
+        }
+
+        pending_.fetch_add(1);
+        wake(false);
+    }
+
+    void push(std::initializer_list<T> lst)
+    {
+        push_range(lst.begin(), lst.end());
+    }
+
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last)
+    {
+        size_t count = 0;
+
+        {
+            Lane& lane = *lanes_[submitter_node()];
+            std::lock_guard<std::mutex> lk {lane.mtx};
+            for (; first != last; ++first, ++count)
+                lane.items.push_back(std::move(*first));
+        }
+
+        pending_.fetch_add(count);
+        wake(true);
+    }
+
+    bool try_pop(T& item)
+    {
+        const size_t home = current_queue_ == this ? current_node_ : topology_.current_node();
+
+        for (size_t i = 0; i < lanes_.size(); ++i)
+        {
+            Lane& lane = *lanes_[(home + i) % lanes_.size()];
+            std::lock_guard<std::mutex> lk {lane.mtx};
+
+            if (!lane.items.empty())
+            {
+                item = std::move(lane.items.front());
+                lane.items.pop_front();
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void pop(T& item)
+    {
+        while (!try_pop(item))
+        {
+            // items are pending but another consumer took them first - try again
+            if (pending_.load() > 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lk {mtx_idle_};
+            sleepers_.fetch_add(1);
+            cv_idle_.wait(lk, [this] { return pending_.load() > 0; });
+            sleepers_.fetch_sub(1);
+        }
+    }
+
+private:
+    struct alignas(64) Lane
+    {
+        std::mutex mtx;
+        std::deque<T> items;
+    };
+
+    CpuTopology topology_;
+    const bool pin_workers_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+
+    alignas(64) std::atomic<size_t> pending_ {0};
+    std::atomic<size_t> sleepers_ {0};
+    std::mutex mtx_idle_;
+    std::condition_variable cv_idle_;
+
+    static inline thread_local NumaTaskQueue* current_queue_ = nullptr;
+    static inline thread_local size_t current_node_ = 0;
+
+    size_t submitter_node() const
+    {
+        return current_queue_ == this ? current_node_ : topology_.current_node();
+    }
+
+    void wake(bool all)
+    {
+        if (sleepers_.load() > 0)
+        {
+            { std::lock_guard<std::mutex> lk {mtx_idle_}; }
+
+            if (all)
+                cv_idle_.notify_all();
+            else
+                cv_idle_.notify_one();
+        }
+    }
+};
+
+#endif // NUMA_TASK_QUEUE_HPP
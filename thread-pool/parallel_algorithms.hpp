@@ -0,0 +1,220 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include "pool_future.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+//////////////////////////////////////////////////////////////////////
+// data-parallel algorithms on top of a thread pool (anything with post(Task) & size())
+//  - the range is split recursively in halves: the right half is posted
+//    to the pool, the left one is processed by the current thread
+//  - splitting stops at grain size; grain == 0 means adaptive grain
+//    (about 8 chunks per worker)
+//  - the calling thread processes a part of the range and then waits until
+//    the rest is done - a worker of BasicThreadPool runs queued tasks while
+//    it waits, so calls can be nested inside pool tasks
+//  - if the pool drops a posted half (e.g. shutdown_now()) the algorithm throws
+//    std::future_error (broken_promise) instead of waiting for it forever
+namespace ver_2_0
+{
+    namespace detail
+    {
+        class ParallelJoin
+        {
+        public:
+            ParallelJoin()
+                : done_ {nullptr}
+                , f_done_ {done_.get_future()}
+            {
+            }
+
+            void fork()
+            {
+                pending_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            void join()
+            {
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (error_)
+                        done_.set_exception(error_);
+                    else
+                        done_.set_value();
+                }
+            }
+
+            void set_error(std::exception_ptr e)
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+                if (!error_)
+                    error_ = std::move(e);
+            }
+
+            void wait()
+            {
+                f_done_.get();
+            }
+
+        private:
+            std::atomic<size_t> pending_ {1};
+            std::mutex mtx_;
+            std::exception_ptr error_;
+            Promise<void> done_;
+            Future<void> f_done_;
+        };
+
+        template <typename TPool>
+        size_t grain_size(const TPool& pool, size_t count, size_t grain)
+        {
+            if (grain == 0)
+                grain = count / (std::max<size_t>(1, pool.size()) * 8);
+
+            return std::max<size_t>(1, grain);
+        }
+
+        template <typename TPool, typename Leaf>
+        void split_and_run(TPool& pool, std::shared_ptr<ParallelJoin> join, size_t first, size_t last, size_t grain, const Leaf& leaf);
+
+        // posted half of a split range - joins with broken_promise if it is dropped without having run
+        //  - no separate flag: the join is moved out when the task runs (keeps the task in Task's inline buffer)
+        template <typename TPool, typename Leaf>
+        class SplitTask
+        {
+        public:
+            SplitTask(TPool& pool, std::shared_ptr<ParallelJoin> join, size_t first, size_t last, size_t grain, const Leaf& leaf)
+                : pool_ {&pool}
+                , join_ {std::move(join)}
+                , first_ {first}
+                , last_ {last}
+                , grain_ {grain}
+                , leaf_ {&leaf}
+            {
+            }
+
+            SplitTask(SplitTask&&) noexcept = default;
+            SplitTask& operator=(SplitTask&&) = delete;
+
+            ~SplitTask()
+            {
+                if (join_)
+                {
+                    join_->set_error(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+                    join_->join();
+                }
+            }
+
+            void operator()()
+            {
+                split_and_run(*pool_, std::move(join_), first_, last_, grain_, *leaf_);
+            }
+
+        private:
+            TPool* pool_;
+            std::shared_ptr<ParallelJoin> join_;
+            size_t first_;
+            size_t last_;
+            size_t grain_;
+            const Leaf* leaf_;
+        };
+
+        // leaf(first, last) is called for disjoint subranges of [first, last)
+        template <typename TPool, typename Leaf>
+        void split_and_run(TPool& pool, std::shared_ptr<ParallelJoin> join, size_t first, size_t last, size_t grain, const Leaf& leaf)
+        {
+            static_assert(Task::fits_inline<SplitTask<TPool, Leaf>>());
+
+            try
+            {
+                while (last - first > grain)
+                {
+                    const size_t middle = first + (last - first) / 2;
+
+                    join->fork(); // a half that is refused or dropped joins when destroyed
+                    pool.post_internal(SplitTask<TPool, Leaf> {pool, join, middle, last, grain, leaf});
+
+                    last = middle;
+                }
+
+                leaf(first, last);
+            }
+            catch (...)
+            {
+                join->set_error(std::current_exception());
+            }
+
+            join->join();
+        }
+
+        template <typename TPool, typename Leaf>
+        void parallel_run(TPool& pool, size_t count, size_t grain, const Leaf& leaf)
+        {
+            if (count == 0)
+                return;
+
+            auto join = std::make_shared<ParallelJoin>();
+            split_and_run(pool, join, 0, count, grain_size(pool, count, grain), leaf);
+            join->wait();
+        }
+    }
+
+    // calls f(i) for every i in [first, last)
+    template <typename TPool, typename Index, typename F>
+    void parallel_for(TPool& pool, Index first, Index last, F f, size_t grain = 0)
+    {
+        if (!(first < last))
+            return;
+
+        detail::parallel_run(pool, static_cast<size_t>(last - first), grain, [first, &f](size_t b, size_t e) {
+            for (size_t i = b; i != e; ++i)
+                f(static_cast<Index>(first + i));
+        });
+    }
+
+    // combines init with f(b, e) partial results of disjoint subranges of [first, last)
+    //  - op must be associative & commutative - partials are combined in completion order
+    template <typename TPool, typename Index, typename T, typename F, typename Op>
+    T parallel_reduce(TPool& pool, Index first, Index last, T init, F f, Op op, size_t grain = 0)
+    {
+        if (!(first < last))
+            return init;
+
+        std::mutex mtx;
+        T result = std::move(init);
+
+        detail::parallel_run(pool, static_cast<size_t>(last - first), grain, [first, &f, &op, &mtx, &result](size_t b, size_t e) {
+            T partial = f(static_cast<Index>(first + b), static_cast<Index>(first + e));
+
+            std::lock_guard<std::mutex> lk {mtx};
+            result = op(std::move(result), std::move(partial));
+        });
+
+        return result;
+    }
+
+    // *(d_first + i) = f(*(first + i)) - random access iterators only
+    template <typename TPool, typename InputIt, typename OutputIt, typename F>
+    OutputIt parallel_transform(TPool& pool, InputIt first, InputIt last, OutputIt d_first, F f, size_t grain = 0)
+    {
+        const auto count = static_cast<size_t>(std::distance(first, last));
+
+        detail::parallel_run(pool, count, grain, [first, d_first, &f](size_t b, size_t e) {
+            auto out = d_first + b;
+            for (auto it = first + b; it != first + e; ++it, ++out)
+                *out = f(*it);
+        });
+
+        return d_first + count;
+    }
+}
+
+#endif // PARALLEL_ALGORITHMS_HPP
@@ -0,0 +1,1002 @@
+#ifndef POOL_FUTURE_HPP
+#define POOL_FUTURE_HPP
+
+#include "executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace ver_2_0
+{
+    template <typename T>
+    class Future;
+
+    template <typename T>
+    class Promise;
+
+    namespace detail
+    {
+        struct FutureAccess;
+
+        inline void cpu_relax()
+        {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+            _mm_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        class SharedStateBase;
+
+        // pool worker that can run queued tasks while it waits for a future
+        class WaitHelper
+        {
+        public:
+            // runs one queued task - false if there was none
+            virtual bool run_pending_task() = 0;
+
+            // blocks until a task is queued or the state changed (e.g. became ready) - may return spuriously
+            virtual void park(SharedStateBase& state) = 0;
+
+        protected:
+            ~WaitHelper() = default;
+        };
+
+        // set for the lifetime of a worker thread of a pool supporting helping waits
+        inline thread_local WaitHelper* current_wait_helper = nullptr;
+
+        //////////////////////////////////////////////////////////////////////
+        // per-pool freelist of fixed-size blocks for future/promise shared states
+        //  - grows in chunks, blocks are never returned to the system
+        //  - destroys itself when the owning pool released it and the last
+        //    outstanding block came back
+        class SharedStateSlab
+        {
+        public:
+            static constexpr size_t block_size = 192;
+            static constexpr size_t blocks_per_chunk = 64;
+
+            struct Releaser
+            {
+                void operator()(SharedStateSlab* slab) const
+                {
+                    slab->release();
+                }
+            };
+
+            using OwnerPtr = std::unique_ptr<SharedStateSlab, Releaser>;
+
+            static OwnerPtr create()
+            {
+                return OwnerPtr {new SharedStateSlab()};
+            }
+
+            SharedStateSlab(const SharedStateSlab&) = delete;
+            SharedStateSlab& operator=(const SharedStateSlab&) = delete;
+
+            void* allocate()
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+
+                if (!free_list_)
+                    grow();
+
+                Block* block = free_list_;
+                free_list_ = block->next;
+                ++outstanding_;
+
+                return block->storage;
+            }
+
+            void deallocate(void* ptr)
+            {
+                bool destroy_slab;
+
+                {
+                    std::lock_guard<std::mutex> lk {mtx_};
+
+                    Block* block = reinterpret_cast<Block*>(ptr);
+                    block->next = free_list_;
+                    free_list_ = block;
+                    --outstanding_;
+
+                    destroy_slab = released_ && outstanding_ == 0;
+                }
+
+                if (destroy_slab)
+                    delete this;
+            }
+
+        private:
+            union Block
+            {
+                Block* next;
+                alignas(std::max_align_t) unsigned char storage[block_size];
+            };
+
+            std::mutex mtx_;
+            Block* free_list_ = nullptr;
+            size_t outstanding_ = 0;
+            bool released_ = false;
+            std::vector<std::unique_ptr<Block[]>> chunks_;
+
+            SharedStateSlab() = default;
+            ~SharedStateSlab() = default;
+
+            void grow()
+            {
+                chunks_.push_back(std::make_unique<Block[]>(blocks_per_chunk));
+                Block* chunk = chunks_.back().get();
+
+                for (size_t i = 0; i < blocks_per_chunk; ++i)
+                {
+                    chunk[i].next = free_list_;
+                    free_list_ = &chunk[i];
+                }
+            }
+
+            void release()
+            {
+                bool destroy_slab;
+
+                {
+                    std::lock_guard<std::mutex> lk {mtx_};
+                    released_ = true;
+                    destroy_slab = outstanding_ == 0;
+                }
+
+                if (destroy_slab)
+                    delete this;
+            }
+        };
+
+        //////////////////////////////////////////////////////////////////////
+        // shared state of Promise/Future
+        //  - readiness is a single atomic word: waiters spin for a while
+        //    and then block with atomic::wait
+        //  - a waiting pool worker runs queued tasks until the state is ready
+        //    (recursive fork-join cannot deadlock) - with nothing to run it parks
+        //    until the state is ready or its pool queues a task
+        //  - owned jointly by a promise and a future (refs_ == 2 at start)
+        //  - a single continuation can be attached - it runs (or is posted to
+        //    its executor) by whichever thread completes the state second:
+        //    the producer or the thread attaching the continuation; completing
+        //    the state never throws because of a failed post
+        //  - a continuation whose task the executor drops is destroyed without running
+        class SharedStateBase
+        {
+        public:
+            SharedStateBase(SharedStateSlab* slab, Executor* executor)
+                : slab_ {slab}
+                , executor_ {executor}
+            {
+            }
+
+            SharedStateBase(const SharedStateBase&) = delete;
+            SharedStateBase& operator=(const SharedStateBase&) = delete;
+
+            virtual ~SharedStateBase() = default;
+
+            void release()
+            {
+                if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    destroy();
+            }
+
+            bool is_ready() const
+            {
+                return status_.load(std::memory_order_acquire) & ready;
+            }
+
+            void wait()
+            {
+                if (WaitHelper* helper = current_wait_helper)
+                {
+                    while (!is_ready())
+                    {
+                        if (helper->run_pending_task() || spin_until_ready())
+                            continue;
+
+                        helper->park(*this);
+                    }
+                    return;
+                }
+
+                if (spin_until_ready())
+                    return;
+
+                for (uint32_t status = status_.load(std::memory_order_acquire); !(status & ready); status = status_.load(std::memory_order_acquire))
+                    status_.wait(status, std::memory_order_acquire);
+            }
+
+            // for WaitHelper::park - status() read before checking for queued tasks,
+            // wait_for_change() returns once the state is ready or wake() was called
+            uint32_t status() const
+            {
+                return status_.load(std::memory_order_seq_cst);
+            }
+
+            void wait_for_change(uint32_t status) const
+            {
+                status_.wait(status, std::memory_order_acquire);
+            }
+
+            void wake()
+            {
+                status_.fetch_add(woken, std::memory_order_acq_rel);
+                status_.notify_all();
+            }
+
+            SharedStateSlab* slab() const
+            {
+                return slab_;
+            }
+
+            // executor of the pool that created the state (may be nullptr)
+            Executor* executor() const
+            {
+                return executor_;
+            }
+
+            // continuation is posted to executor (or run inline when executor is nullptr) once the state is ready
+            void set_continuation(Task continuation, Executor* executor)
+            {
+                continuation_ = std::move(continuation);
+                continuation_executor_ = executor;
+
+                if (status_.fetch_or(has_continuation, std::memory_order_acq_rel) & ready)
+                    run_continuation();
+            }
+
+            void set_exception(std::exception_ptr e)
+            {
+                exception_ = std::move(e);
+                mark_ready();
+            }
+
+        protected:
+            static constexpr uint32_t ready = 1;
+            static constexpr uint32_t has_continuation = 2;
+            static constexpr uint32_t woken = 4; // wake() counter in the upper bits
+            static constexpr int spin_count = 128;
+
+            bool spin_until_ready() const
+            {
+                for (int i = 0; i < spin_count; ++i)
+                {
+                    if (is_ready())
+                        return true;
+                    cpu_relax();
+                }
+
+                return false;
+            }
+
+            std::exception_ptr exception_;
+
+            void mark_ready()
+            {
+                const uint32_t previous = status_.fetch_or(ready, std::memory_order_acq_rel);
+                status_.notify_all();
+
+                if (previous & has_continuation)
+                    run_continuation();
+            }
+
+            void rethrow_if_exception() const
+            {
+                if (exception_)
+                    std::rethrow_exception(exception_);
+            }
+
+        private:
+            std::atomic<uint32_t> status_ {0};
+            std::atomic<uint32_t> refs_ {2};
+            SharedStateSlab* slab_;
+            Executor* executor_;
+            Executor* continuation_executor_ = nullptr;
+            Task continuation_;
+
+            // keeps the state alive until a posted continuation ran (or the task was dropped)
+            class StateRef
+            {
+            public:
+                explicit StateRef(SharedStateBase* state)
+                    : state_ {state}
+                {
+                    state_->refs_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                StateRef(StateRef&& other) noexcept
+                    : state_ {std::exchange(other.state_, nullptr)}
+                {
+                }
+
+                StateRef& operator=(StateRef&&) = delete;
+
+                ~StateRef()
+                {
+                    if (state_)
+                        state_->release();
+                }
+
+                SharedStateBase* operator->() const
+                {
+                    return state_;
+                }
+
+            private:
+                SharedStateBase* state_;
+            };
+
+            // the continuation leaves the state only when its task runs - if the executor
+            // drops the task (or post throws), the continuation is destroyed: its future
+            // reports broken_promise and the antecedent it holds is released
+            void run_continuation()
+            {
+                if (!continuation_executor_)
+                {
+                    std::exchange(continuation_, nullptr)();
+                    return;
+                }
+
+                try
+                {
+                    continuation_executor_->post_internal(DroppableTask {
+                        [state = StateRef {this}] { std::exchange(state->continuation_, nullptr)(); },
+                        [this] { Task dropped = std::exchange(continuation_, nullptr); }});
+                }
+                catch (...)
+                {
+                    // the task is gone - so is the continuation
+                }
+            }
+
+            void destroy()
+            {
+                SharedStateSlab* slab = slab_;
+                this->~SharedStateBase();
+
+                if (slab)
+                    slab->deallocate(this);
+                else
+                    ::operator delete(this);
+            }
+        };
+
+        //////////////////////////////////////////////////////////////////////
+        // workers of a pool parked in a helping wait - the pool calls wake_all()
+        // whenever it queues a task, so that they can run it
+        class ParkedHelpers
+        {
+        public:
+            // parks on state unless has_work() - registered first, so a task queued
+            // after the check wakes the helper
+            template <typename HasWork>
+            void park(SharedStateBase& state, HasWork has_work)
+            {
+                {
+                    std::lock_guard<std::mutex> lk {mtx_};
+                    states_.push_back(&state);
+                    count_.fetch_add(1, std::memory_order_seq_cst);
+                }
+
+                const uint32_t status = state.status();
+                if (has_work())
+                    std::this_thread::yield(); // e.g. only stop tasks are queued
+                else
+                    state.wait_for_change(status);
+
+                std::lock_guard<std::mutex> lk {mtx_};
+                states_.erase(std::find(states_.begin(), states_.end(), &state));
+                count_.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            // cheap when nobody is parked - a single fence and load
+            void wake_all()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (count_.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                std::lock_guard<std::mutex> lk {mtx_};
+                for (SharedStateBase* state : states_)
+                    state->wake();
+            }
+
+        private:
+            std::mutex mtx_;
+            std::vector<SharedStateBase*> states_;
+            std::atomic<size_t> count_ {0};
+        };
+
+        template <typename T>
+        class SharedState : public SharedStateBase
+        {
+        public:
+            using SharedStateBase::SharedStateBase;
+
+            ~SharedState() override
+            {
+                if (has_value_)
+                    value()->~T();
+            }
+
+            template <typename U>
+            void set_value(U&& value)
+            {
+                ::new (static_cast<void*>(storage_)) T(std::forward<U>(value));
+                has_value_ = true;
+                mark_ready();
+            }
+
+            T get()
+            {
+                wait();
+                rethrow_if_exception();
+                return std::move(*value());
+            }
+
+        private:
+            alignas(T) unsigned char storage_[sizeof(T)];
+            bool has_value_ = false;
+
+            T* value()
+            {
+                return std::launder(reinterpret_cast<T*>(storage_));
+            }
+        };
+
+        template <>
+        class SharedState<void> : public SharedStateBase
+        {
+        public:
+            using SharedStateBase::SharedStateBase;
+
+            void set_value()
+            {
+                mark_ready();
+            }
+
+            void get()
+            {
+                wait();
+                rethrow_if_exception();
+            }
+        };
+
+        template <typename T>
+        SharedState<T>* make_shared_state(SharedStateSlab* slab, Executor* executor)
+        {
+            if constexpr (sizeof(SharedState<T>) <= SharedStateSlab::block_size
+                && alignof(SharedState<T>) <= alignof(std::max_align_t))
+            {
+                if (slab)
+                    return ::new (slab->allocate()) SharedState<T>(slab, executor);
+            }
+
+            return ::new (::operator new(sizeof(SharedState<T>))) SharedState<T>(nullptr, executor);
+        }
+
+        template <typename T, typename F>
+        struct continuation_result
+        {
+            using type = std::invoke_result_t<F&, T>;
+        };
+
+        template <typename F>
+        struct continuation_result<void, F>
+        {
+            using type = std::invoke_result_t<F&>;
+        };
+
+        template <typename T, typename F>
+        using continuation_result_t = typename continuation_result<T, F>::type;
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    // Future<T> - lightweight replacement of std::future returned by ThreadPool::submit
+    template <typename T>
+    class Future
+    {
+    public:
+        Future() = default;
+
+        Future(const Future&) = delete;
+        Future& operator=(const Future&) = delete;
+
+        Future(Future&& other) noexcept
+            : state_ {std::exchange(other.state_, nullptr)}
+        {
+        }
+
+        Future& operator=(Future&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                state_ = std::exchange(other.state_, nullptr);
+            }
+
+            return *this;
+        }
+
+        ~Future()
+        {
+            reset();
+        }
+
+        bool valid() const noexcept
+        {
+            return state_ != nullptr;
+        }
+
+        bool is_ready() const
+        {
+            check_state();
+            return state_->is_ready();
+        }
+
+        void wait() const
+        {
+            check_state();
+            state_->wait();
+        }
+
+        // f(value) is scheduled on the executor of the pool that created this future
+        // as soon as the value is ready; an exception skips f and is passed to the result
+        //  - the future is consumed (valid() == false afterwards)
+        template <typename F>
+        auto then(F&& f) -> Future<detail::continuation_result_t<T, std::decay_t<F>>>
+        {
+            check_state();
+            return then(state_->executor(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        auto then(Executor& executor, F&& f) -> Future<detail::continuation_result_t<T, std::decay_t<F>>>
+        {
+            check_state();
+            return then(&executor, std::forward<F>(f));
+        }
+
+        T get()
+        {
+            check_state();
+
+            struct StateGuard
+            {
+                Future& future;
+                ~StateGuard() { future.reset(); }
+            } guard {*this};
+
+            return state_->get();
+        }
+
+    private:
+        detail::SharedState<T>* state_ = nullptr;
+
+        explicit Future(detail::SharedState<T>* state)
+            : state_ {state}
+        {
+        }
+
+        void check_state() const
+        {
+            if (!state_)
+                throw std::future_error(std::future_errc::no_state);
+        }
+
+        void reset()
+        {
+            if (state_)
+                std::exchange(state_, nullptr)->release();
+        }
+
+        template <typename F>
+        auto then(Executor* executor, F&& f) -> Future<detail::continuation_result_t<T, std::decay_t<F>>>
+        {
+            using ResultT = detail::continuation_result_t<T, std::decay_t<F>>;
+
+            detail::SharedState<T>* state = state_;
+            Promise<ResultT> promise(state->slab(), state->executor());
+            Future<ResultT> f_result = promise.get_future();
+
+            state->set_continuation(
+                [antecedent = std::move(*this), promise = std::move(promise), f = std::forward<F>(f)]() mutable
+                {
+                    auto step = [&]() -> ResultT
+                    {
+                        if constexpr (std::is_void_v<T>)
+                        {
+                            antecedent.get();
+                            return f();
+                        }
+                        else
+                            return f(antecedent.get());
+                    };
+                    promise.set_result_of(step);
+                },
+                executor);
+
+            return f_result;
+        }
+
+        template <typename U>
+        friend class Future;
+
+        friend class Promise<T>;
+        friend struct detail::FutureAccess;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // Promise<T> - producer side of Future<T>
+    //  - an unfulfilled promise sets std::future_errc::broken_promise when destroyed
+    template <typename T>
+    class Promise
+    {
+    public:
+        Promise() = default;
+
+        explicit Promise(detail::SharedStateSlab* slab, Executor* executor = nullptr)
+            : state_ {detail::make_shared_state<T>(slab, executor)}
+        {
+        }
+
+        Promise(const Promise&) = delete;
+        Promise& operator=(const Promise&) = delete;
+
+        Promise(Promise&& other) noexcept
+            : state_ {std::exchange(other.state_, nullptr)}
+            , future_retrieved_ {other.future_retrieved_}
+            , satisfied_ {other.satisfied_}
+        {
+        }
+
+        Promise& operator=(Promise&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                state_ = std::exchange(other.state_, nullptr);
+                future_retrieved_ = other.future_retrieved_;
+                satisfied_ = other.satisfied_;
+            }
+
+            return *this;
+        }
+
+        ~Promise()
+        {
+            reset();
+        }
+
+        Future<T> get_future()
+        {
+            check_state();
+
+            if (future_retrieved_)
+                throw std::future_error(std::future_errc::future_already_retrieved);
+
+            future_retrieved_ = true;
+            return Future<T>(state_);
+        }
+
+        template <typename... TValue>
+        void set_value(TValue&&... value)
+        {
+            check_not_satisfied();
+            state_->set_value(std::forward<TValue>(value)...);
+            satisfied_ = true;
+        }
+
+        void set_exception(std::exception_ptr e)
+        {
+            check_not_satisfied();
+            state_->set_exception(std::move(e));
+            satisfied_ = true;
+        }
+
+        // invokes f and stores its result (or exception) in the shared state
+        template <typename F>
+        void set_result_of(F& f)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    f();
+                    set_value();
+                }
+                else
+                    set_value(f());
+            }
+            catch (...)
+            {
+                set_exception(std::current_exception());
+            }
+        }
+
+    private:
+        detail::SharedState<T>* state_ = nullptr;
+        bool future_retrieved_ = false;
+        bool satisfied_ = false;
+
+        void check_state() const
+        {
+            if (!state_)
+                throw std::future_error(std::future_errc::no_state);
+        }
+
+        void check_not_satisfied() const
+        {
+            check_state();
+
+            if (satisfied_)
+                throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+
+        void reset()
+        {
+            if (!state_)
+                return;
+
+            if (!satisfied_)
+                state_->set_exception(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+
+            // the future side was never created - drop its reference as well
+            if (!future_retrieved_)
+                state_->release();
+
+            std::exchange(state_, nullptr)->release();
+        }
+    };
+
+    namespace detail
+    {
+        struct FutureAccess
+        {
+            template <typename T>
+            static SharedState<T>* state(Future<T>& future)
+            {
+                future.check_state();
+                return future.state_;
+            }
+        };
+
+        template <typename T>
+        Executor* executor_of(std::vector<Future<T>>& futures)
+        {
+            return futures.empty() ? nullptr : FutureAccess::state(futures.front())->executor();
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    // when_all - future that becomes ready when every input future is ready
+    //  - the result holds the input futures, all of them ready
+    //  - completion is counted by callbacks on the input states, no thread waits
+    template <typename T>
+    Future<std::vector<Future<T>>> when_all(std::vector<Future<T>> futures)
+    {
+        struct WhenAllState
+        {
+            std::atomic<size_t> pending;
+            std::vector<Future<T>> futures;
+            Promise<std::vector<Future<T>>> promise;
+
+            void arrive()
+            {
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    promise.set_value(std::move(futures));
+            }
+        };
+
+        for (auto& f : futures)
+            detail::FutureAccess::state(f);
+
+        auto when_all_state = std::make_shared<WhenAllState>();
+        when_all_state->promise = Promise<std::vector<Future<T>>>(nullptr, detail::executor_of(futures));
+        when_all_state->pending.store(futures.size() + 1, std::memory_order_relaxed); // +1 - futures are not moved out while callbacks are attached
+        when_all_state->futures = std::move(futures);
+
+        Future<std::vector<Future<T>>> f_result = when_all_state->promise.get_future();
+
+        for (auto& f : when_all_state->futures)
+            detail::FutureAccess::state(f)->set_continuation([when_all_state] { when_all_state->arrive(); }, nullptr);
+
+        when_all_state->arrive();
+
+        return f_result;
+    }
+
+    template <typename InputIt>
+    auto when_all(InputIt first, InputIt last)
+    {
+        using FutureT = typename std::iterator_traits<InputIt>::value_type;
+        return when_all(std::vector<FutureT>(std::make_move_iterator(first), std::make_move_iterator(last)));
+    }
+
+    template <typename T>
+    struct WhenAnyResult
+    {
+        size_t index; // position of the first ready future (-1 for an empty input)
+        std::vector<Future<T>> futures;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // when_any - future that becomes ready when the first input future is ready
+    //  - every input is forwarded to a fresh future of the result, so the
+    //    futures still pending can be passed to the next when_any (or then)
+    //  - every call re-wraps the pending futures - use CompletionQueue to
+    //    process many results in completion order
+    template <typename T>
+    Future<WhenAnyResult<T>> when_any(std::vector<Future<T>> futures)
+    {
+        struct WhenAnyState
+        {
+            std::atomic<bool> done {false};
+            std::vector<Future<T>> futures;
+            Promise<WhenAnyResult<T>> promise;
+        };
+
+        for (auto& f : futures)
+            detail::FutureAccess::state(f);
+
+        auto when_any_state = std::make_shared<WhenAnyState>();
+        when_any_state->promise = Promise<WhenAnyResult<T>>(nullptr, detail::executor_of(futures));
+
+        Future<WhenAnyResult<T>> f_result = when_any_state->promise.get_future();
+
+        if (futures.empty())
+        {
+            when_any_state->promise.set_value(WhenAnyResult<T> {static_cast<size_t>(-1), {}});
+            return f_result;
+        }
+
+        std::vector<Promise<T>> forwards;
+        forwards.reserve(futures.size());
+        when_any_state->futures.reserve(futures.size());
+
+        for (auto& f : futures)
+        {
+            detail::SharedState<T>* state = detail::FutureAccess::state(f);
+            forwards.emplace_back(state->slab(), state->executor());
+            when_any_state->futures.push_back(forwards.back().get_future());
+        }
+
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            detail::SharedState<T>* state = detail::FutureAccess::state(futures[i]);
+
+            state->set_continuation(
+                [when_any_state, i, source = std::move(futures[i]), forward = std::move(forwards[i])]() mutable
+                {
+                    auto get_source = [&source] { return source.get(); };
+                    forward.set_result_of(get_source);
+
+                    if (!when_any_state->done.exchange(true, std::memory_order_acq_rel))
+                        when_any_state->promise.set_value(WhenAnyResult<T> {i, std::move(when_any_state->futures)});
+                },
+                nullptr);
+        }
+
+        return f_result;
+    }
+
+    template <typename InputIt>
+    auto when_any(InputIt first, InputIt last)
+    {
+        using FutureT = typename std::iterator_traits<InputIt>::value_type;
+        return when_any(std::vector<FutureT>(std::make_move_iterator(first), std::make_move_iterator(last)));
+    }
+
+    template <typename T>
+    struct ReadyFuture
+    {
+        size_t index; // position of the future in the input
+        Future<T> future;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // CompletionQueue - hands out the input futures in the order they become ready
+    //  - a single callback per input appends its index to a ready queue - O(n) in
+    //    total, the futures are never re-wrapped
+    //  - the ready queue is a sequence of futures filled in completion order,
+    //    so next() waits like Future::get() (a pool worker runs queued tasks meanwhile)
+    //  - may be destroyed with futures still pending
+    template <typename T>
+    class CompletionQueue
+    {
+    public:
+        explicit CompletionQueue(std::vector<Future<T>> futures)
+            : state_ {std::make_shared<State>()}
+        {
+            for (auto& f : futures)
+                detail::FutureAccess::state(f);
+
+            state_->futures = std::move(futures);
+            state_->ready.reserve(state_->futures.size());
+            ready_.reserve(state_->futures.size());
+
+            for (auto& f : state_->futures)
+            {
+                detail::SharedState<T>* state = detail::FutureAccess::state(f);
+                state_->ready.emplace_back(state->slab(), state->executor());
+                ready_.push_back(state_->ready.back().get_future());
+            }
+
+            for (size_t i = 0; i < state_->futures.size(); ++i)
+                detail::FutureAccess::state(state_->futures[i])->set_continuation([state = state_, i] { state->arrive(i); }, nullptr);
+        }
+
+        template <typename InputIt>
+        CompletionQueue(InputIt first, InputIt last)
+            : CompletionQueue {std::vector<Future<T>>(std::make_move_iterator(first), std::make_move_iterator(last))}
+        {
+        }
+
+        CompletionQueue(const CompletionQueue&) = delete;
+        CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+        // futures not handed out yet
+        size_t size() const
+        {
+            return ready_.size() - next_;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        // waits for the next ready input - throws std::out_of_range when the queue is empty
+        ReadyFuture<T> next()
+        {
+            if (empty())
+                throw std::out_of_range("No pending futures");
+
+            const size_t index = ready_[next_++].get();
+            return ReadyFuture<T> {index, std::move(state_->futures[index])};
+        }
+
+    private:
+        struct State
+        {
+            std::vector<Future<T>> futures;
+            std::vector<Promise<size_t>> ready; // ready[k] - index of the k-th input to complete
+            std::atomic<size_t> completed {0};
+
+            void arrive(size_t index)
+            {
+                ready[completed.fetch_add(1, std::memory_order_relaxed)].set_value(index);
+            }
+        };
+
+        std::shared_ptr<State> state_;
+        std::vector<Future<size_t>> ready_;
+        size_t next_ = 0;
+    };
+}
+
+#endif // POOL_FUTURE_HPP
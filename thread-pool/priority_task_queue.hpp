@@ -0,0 +1,172 @@
+#ifndef PRIORITY_TASK_QUEUE_HPP
+#define PRIORITY_TASK_QUEUE_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+
+enum class TaskPriority
+{
+    high,
+    normal,
+    background
+};
+
+//////////////////////////////////////////////////////////////////////
+// queue with one FIFO lane per TaskPriority
+//  - lanes are served by weighted round-robin: in every round a lane can
+//    hand out at most weight items (high: 8, normal: 4, background: 1)
+//  - a lane with work is never starved - it gets its share in every round
+//  - push without priority goes to the normal lane (drop-in for ThreadSafeQueue)
+//  - pop() returns false once the queue is closed and drained
+template <typename T>
+class PriorityTaskQueue
+{
+public:
+    static constexpr bool is_fifo = false;
+    static constexpr size_t lane_count = 3;
+    using Weights = std::array<size_t, lane_count>;
+
+    explicit PriorityTaskQueue(Weights weights = {8, 4, 1})
+        : weights_ {weights}
+    {
+        for (auto& w : weights_)
+            if (w == 0)
+                w = 1;
+        credits_ = weights_;
+    }
+
+    PriorityTaskQueue(const PriorityTaskQueue&) = delete;
+    PriorityTaskQueue& operator=(const PriorityTaskQueue&) = delete;
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            closed_ = true;
+        }
+
+        cv_not_empty_.notify_all();
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lk {mtx_};
+        return size_ == 0;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lk {mtx_};
+        return size_;
+    }
+
+    size_t size(TaskPriority priority) const
+    {
+        std::lock_guard<std::mutex> lk {mtx_};
+        return lanes_[index(priority)].size();
+    }
+
+    void push(const T& item, TaskPriority priority = TaskPriority::normal)
+    {
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            lanes_[index(priority)].push_back(item);
+            ++size_;
+        }
+
+        cv_not_empty_.notify_one();
+    }
+
+    void push(T&& item, TaskPriority priority = TaskPriority::normal)
+    {
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            lanes_[index(priority)].push_back(std::move(item));
+            ++size_;
+        }
+
+        cv_not_empty_.notify_one();
+    }
+
+    void push(std::initializer_list<T> lst)
+    {
+        push_range(lst.begin(), lst.end());
+    }
+
+    template <typename InputIt>
+    void push_range(InputIt first, InputIt last, TaskPriority priority = TaskPriority::normal)
+    {
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            for (; first != last; ++first, ++size_)
+                lanes_[index(priority)].push_back(std::move(*first));
+        }
+
+        cv_not_empty_.notify_all();
+    }
+
+    bool try_pop(T& item)
+    {
+        std::unique_lock<std::mutex> lk {mtx_, std::try_to_lock};
+        if (!lk.owns_lock() || size_ == 0)
+            return false;
+
+        pop_next(item);
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lk {mtx_};
+        cv_not_empty_.wait(lk, [this] { return size_ != 0 || closed_; });
+
+        if (size_ == 0)
+            return false;
+
+        pop_next(item);
+        return true;
+    }
+
+private:
+    mutable std::mutex mtx_;
+    std::condition_variable cv_not_empty_;
+    std::array<std::deque<T>, lane_count> lanes_;
+    Weights weights_;
+    Weights credits_;
+    size_t size_ = 0;
+    bool closed_ = false;
+
+    static size_t index(TaskPriority priority)
+    {
+        return static_cast<size_t>(priority);
+    }
+
+    // precondition: size_ > 0 & mtx_ is locked
+    void pop_next(T& item)
+    {
+        while (true)
+        {
+            for (size_t i = 0; i < lane_count; ++i)
+            {
+                if (!lanes_[i].empty() && credits_[i] > 0)
+                {
+                    --credits_[i];
+                    item = std::move(lanes_[i].front());
+                    lanes_[i].pop_front();
+                    --size_;
+                    return;
+                }
+            }
+
+            // every lane with work used up its share - next round
+            credits_ = weights_;
+        }
+    }
+};
+
+#endif // PRIORITY_TASK_QUEUE_HPP
@@ -0,0 +1,394 @@
+#ifndef SHARED_SCHEDULER_HPP
+#define SHARED_SCHEDULER_HPP
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ver_2_0
+{
+    struct PoolViewOptions
+    {
+        size_t weight = 1;      // share of the workers while other views have queued tasks
+        size_t max_threads = 0; // quota: tasks of the view running at the same time (0 - no limit)
+    };
+
+    struct PoolViewStats
+    {
+        size_t queued;
+        size_t running;
+        size_t executed;
+        std::chrono::nanoseconds busy_time; // total run time of the view's tasks
+    };
+
+    class PoolView;
+
+    //////////////////////////////////////////////////////////////////////
+    // one set of worker threads shared by several pool views - subsystems get isolated
+    // queues without oversubscribing the machine with a thread pool each
+    //  - a worker runs the next task of the view that used the least run time per weight
+    //    (virtual time) - with all views busy each gets workers in proportion to its weight;
+    //    an idle view is not credited for the time it had nothing to run
+    //  - a view at its max_threads quota is skipped until one of its tasks completes
+    //  - Future::get()/wait() called by a task runs other queued tasks until the result is
+    //    ready (quotas still apply, except to the view of the waiting task) and parks while
+    //    there is nothing it may run
+    //  - instance() is the process-wide scheduler with one worker per core
+    //  - views must be destroyed before their scheduler
+    class SharedScheduler
+    {
+    public:
+        explicit SharedScheduler(size_t thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            if (thread_count == 0)
+                throw std::invalid_argument("Thread count must be positive");
+
+            threads_.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i)
+                threads_.emplace_back([this, i]
+                    { run(i); });
+        }
+
+        SharedScheduler(const SharedScheduler&) = delete;
+        SharedScheduler& operator=(const SharedScheduler&) = delete;
+
+        // tasks still queued run first
+        ~SharedScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+                stop_ = true;
+            }
+            cv_work_.notify_all();
+
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        static SharedScheduler& instance()
+        {
+            static SharedScheduler scheduler;
+            return scheduler;
+        }
+
+        size_t size() const
+        {
+            return threads_.size();
+        }
+
+    private:
+        friend class PoolView;
+
+        struct ViewState
+        {
+            explicit ViewState(PoolViewOptions options)
+                : weight {static_cast<double>(options.weight)}
+                , max_threads {options.max_threads}
+            {
+            }
+
+            const double weight;
+            const size_t max_threads;
+            std::deque<Task> tasks;
+            size_t running = 0;
+            size_t executed = 0;
+            double virtual_time = 0;  // run time (ns) / weight
+            double avg_run_ns = 0;    // charged when a task starts, corrected when it completes
+            int64_t busy_ns = 0;
+            bool accepting = true;    // false once aborted - posted tasks are dropped
+            bool attached = true;
+            bool draining = false;
+        };
+
+        std::vector<std::thread> threads_;
+        std::mutex mtx_; // never held while a task runs or is destroyed
+        std::condition_variable cv_work_;
+        std::condition_variable cv_drained_;
+        std::vector<ViewState*> views_;
+        double virtual_time_ = 0; // virtual time of the last view picked
+        size_t idle_workers_ = 0;
+        bool stop_ = false;
+        detail::ParkedHelpers parked_helpers_;
+
+        static inline thread_local const ViewState* current_view_ = nullptr;
+
+        class WorkerWaitHelper : public detail::WaitHelper
+        {
+        public:
+            explicit WorkerWaitHelper(SharedScheduler& scheduler)
+                : scheduler_ {scheduler}
+            {
+            }
+
+            bool run_pending_task() override
+            {
+                std::unique_lock<std::mutex> lk {scheduler_.mtx_};
+
+                ViewState* view = scheduler_.next_view();
+                if (!view)
+                    return false;
+
+                scheduler_.run_task(lk, *view);
+                return true;
+            }
+
+            void park(detail::SharedStateBase& state) override
+            {
+                scheduler_.parked_helpers_.park(state, [this]
+                    {
+                        std::lock_guard<std::mutex> lk {scheduler_.mtx_};
+                        return scheduler_.next_view() != nullptr;
+                    });
+            }
+
+        private:
+            SharedScheduler& scheduler_;
+        };
+
+        void attach(ViewState& view)
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            views_.push_back(&view);
+        }
+
+        void push(ViewState& view, Task task)
+        {
+            bool wake = false;
+            bool queued = false;
+
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+
+                if (view.attached && view.accepting)
+                {
+                    // an idle view starts at the current virtual time - it cannot claim the time it missed
+                    if (view.tasks.empty())
+                        view.virtual_time = std::max(view.virtual_time, virtual_time_);
+
+                    view.tasks.push_back(std::move(task));
+                    wake = idle_workers_ > 0 && below_quota(view);
+                    queued = true;
+                }
+            }
+
+            if (wake)
+                cv_work_.notify_one();
+
+            if (queued)
+                parked_helpers_.wake_all();
+
+            // a dropped task is destroyed here, outside the lock - its future reports broken_promise
+        }
+
+        void shutdown(ViewState& view, ShutdownMode mode)
+        {
+            if (detail::current_worker.pool == this)
+                throw std::logic_error("Pool view cannot be shut down by a task of its scheduler");
+
+            std::deque<Task> discarded;
+
+            std::unique_lock<std::mutex> lk {mtx_};
+            if (!view.attached)
+                return;
+
+            if (mode == ShutdownMode::abort)
+            {
+                view.accepting = false;
+                discarded.swap(view.tasks);
+
+                lk.unlock();
+                discarded.clear();
+                lk.lock();
+            }
+
+            view.draining = true;
+            cv_drained_.wait(lk, [&view] { return view.tasks.empty() && view.running == 0; });
+
+            view.attached = false;
+            views_.erase(std::find(views_.begin(), views_.end(), &view));
+        }
+
+        PoolViewStats stats(const ViewState& view)
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            return PoolViewStats {view.tasks.size(), view.running, view.executed, std::chrono::nanoseconds {view.busy_ns}};
+        }
+
+        // precondition: mtx_ is locked
+        bool below_quota(const ViewState& view) const
+        {
+            return view.max_threads == 0 || view.running < view.max_threads || &view == current_view_;
+        }
+
+        // precondition: mtx_ is locked
+        ViewState* next_view() const
+        {
+            ViewState* next = nullptr;
+
+            for (ViewState* view : views_)
+            {
+                if (!view->tasks.empty() && below_quota(*view) && (!next || view->virtual_time < next->virtual_time))
+                    next = view;
+            }
+
+            return next;
+        }
+
+        // runs the next task of view with mtx_ unlocked - lk is locked again on return
+        void run_task(std::unique_lock<std::mutex>& lk, ViewState& view)
+        {
+            Task task = std::move(view.tasks.front());
+            view.tasks.pop_front();
+            ++view.running;
+
+            virtual_time_ = std::max(virtual_time_, view.virtual_time);
+            const double charged = view.avg_run_ns;
+            view.virtual_time += charged / view.weight;
+
+            lk.unlock();
+
+            const ViewState* previous = std::exchange(current_view_, &view);
+            const auto started = std::chrono::steady_clock::now();
+            task();
+            const auto finished = std::chrono::steady_clock::now();
+            current_view_ = previous;
+            task = nullptr;
+
+            const int64_t run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count();
+
+            lk.lock();
+
+            const bool was_at_quota = view.max_threads != 0 && view.running == view.max_threads;
+            --view.running;
+            ++view.executed;
+            view.busy_ns += run_ns;
+            view.virtual_time += (run_ns - charged) / view.weight;
+            view.avg_run_ns = view.avg_run_ns == 0 ? run_ns : view.avg_run_ns + (run_ns - view.avg_run_ns) / 8;
+
+            // a worker may have parked while the view was at its quota
+            if (was_at_quota && !view.tasks.empty())
+            {
+                if (idle_workers_ > 0)
+                    cv_work_.notify_one();
+                parked_helpers_.wake_all();
+            }
+
+            if (view.draining && view.tasks.empty() && view.running == 0)
+                cv_drained_.notify_all();
+        }
+
+        void run(size_t index)
+        {
+            WorkerWaitHelper wait_helper {*this};
+            detail::current_wait_helper = &wait_helper;
+            detail::current_worker = detail::WorkerContext {this, index};
+
+            std::unique_lock<std::mutex> lk {mtx_};
+
+            while (true)
+            {
+                if (ViewState* view = next_view())
+                {
+                    run_task(lk, *view);
+                    continue;
+                }
+
+                if (stop_)
+                    break;
+
+                ++idle_workers_;
+                cv_work_.wait(lk);
+                --idle_workers_;
+            }
+
+            lk.unlock();
+
+            detail::current_wait_helper = nullptr;
+            detail::current_worker = detail::WorkerContext {};
+        }
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // lightweight executor with its own queue on the workers of a SharedScheduler -
+    // a drop-in for a subsystem's ThreadPool that starts no threads of its own
+    //  - tasks of one view start in FIFO order; views do not share queues
+    //  - the destructor drains the view's queue (like ~ThreadPool) - other views are not affected
+    class PoolView : public Executor
+    {
+    public:
+        explicit PoolView(PoolViewOptions options = {})
+            : PoolView {SharedScheduler::instance(), options}
+        {
+        }
+
+        PoolView(SharedScheduler& scheduler, PoolViewOptions options = {})
+            : scheduler_ {scheduler}
+            , state_ {options}
+        {
+            if (options.weight == 0)
+                throw std::invalid_argument("Weight must be positive");
+
+            scheduler_.attach(state_);
+        }
+
+        PoolView(const PoolView&) = delete;
+        PoolView& operator=(const PoolView&) = delete;
+
+        ~PoolView()
+        {
+            shutdown(ShutdownMode::drain);
+        }
+
+        void post(Task task) override
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            scheduler_.push(state_, std::move(task));
+        }
+
+        template <typename F>
+        auto submit(F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = detail::package_task(slab_.get(), this, std::forward<F>(f));
+            scheduler_.push(state_, std::move(task));
+            return std::move(f_result);
+        }
+
+        // detaches the view from the scheduler once its tasks are done - must not be called by a task of the scheduler
+        //  - drain: queued tasks (and tasks they post meanwhile) run first
+        //  - abort: queued tasks are discarded, running tasks complete
+        // tasks posted after shutdown never run - their futures report broken_promise
+        void shutdown(ShutdownMode mode = ShutdownMode::drain)
+        {
+            scheduler_.shutdown(state_, mode);
+        }
+
+        PoolViewStats stats() const
+        {
+            return scheduler_.stats(state_);
+        }
+
+        SharedScheduler& scheduler() const
+        {
+            return scheduler_;
+        }
+
+    private:
+        SharedScheduler& scheduler_;
+        SharedScheduler::ViewState state_;
+        detail::SharedStateSlab::OwnerPtr slab_ = detail::SharedStateSlab::create();
+    };
+}
+
+#endif // SHARED_SCHEDULER_HPP
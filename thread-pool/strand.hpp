@@ -0,0 +1,151 @@
+#ifndef STRAND_HPP
+#define STRAND_HPP
+
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace ver_2_0
+{
+    //////////////////////////////////////////////////////////////////////
+    // serial executor on top of another executor (e.g. ThreadPool)
+    //  - tasks posted to a strand run one at a time in FIFO order on whichever
+    //    worker is free - state touched only by the strand's tasks needs no lock
+    //  - different strands run in parallel
+    //  - at most one drain task per strand is queued in the underlying executor;
+    //    it runs up to batch_size tasks and re-posts itself so that busy strands
+    //    do not monopolize the workers
+    //  - the strand may be destroyed while tasks are pending - they still run
+    //  - if the executor drops the drain task (e.g. shutdown_now()) the queued tasks are
+    //    discarded - their futures report broken_promise; later tasks are scheduled anew
+    class Strand : public Executor
+    {
+    public:
+        static constexpr size_t default_batch_size = 64;
+
+        explicit Strand(Executor& executor, size_t batch_size = default_batch_size)
+            : state_ {std::make_shared<State>(executor, batch_size)}
+        {
+            if (batch_size == 0)
+                throw std::invalid_argument("Batch size must be positive");
+        }
+
+        Strand(const Strand&) = delete;
+        Strand& operator=(const Strand&) = delete;
+
+        void post(Task task) override
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            State::post(state_, std::move(task));
+        }
+
+        // continuations (then, co_await) of the returned future also run on the strand
+        template <typename F>
+        auto submit(F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = detail::package_task(nullptr, this, std::forward<F>(f));
+            post(std::move(task));
+            return std::move(f_result);
+        }
+
+        // true if called from a task of this strand
+        bool running_in_this_thread() const
+        {
+            return State::current == state_.get();
+        }
+
+    private:
+        class State
+        {
+        public:
+            State(Executor& executor, size_t batch_size)
+                : executor_ {executor}
+                , batch_size_ {batch_size}
+            {
+            }
+
+            static inline thread_local const State* current = nullptr;
+
+            static void post(const std::shared_ptr<State>& state, Task task)
+            {
+                bool schedule;
+
+                {
+                    std::lock_guard<std::mutex> lk {state->mtx_};
+                    state->tasks_.push_back(std::move(task));
+                    schedule = !std::exchange(state->scheduled_, true);
+                }
+
+                if (schedule)
+                    schedule_drain(state);
+            }
+
+        private:
+            Executor& executor_;
+            const size_t batch_size_;
+            std::mutex mtx_; // guards only the queue - never held while a task runs
+            std::deque<Task> tasks_;
+            bool scheduled_ = false;
+
+            static void schedule_drain(std::shared_ptr<State> state)
+            {
+                Executor& executor = state->executor_;
+                executor.post_internal(detail::DroppableTask {
+                    [state]() mutable { drain(std::move(state)); },
+                    [state = std::move(state)] { discard(*state); }});
+            }
+
+            static void discard(State& state)
+            {
+                std::deque<Task> dropped;
+
+                {
+                    std::lock_guard<std::mutex> lk {state.mtx_};
+                    dropped.swap(state.tasks_);
+                    state.scheduled_ = false;
+                }
+            }
+
+            static void drain(std::shared_ptr<State> state)
+            {
+                const State* previous = std::exchange(current, state.get());
+
+                for (size_t i = 0; i < state->batch_size_; ++i)
+                {
+                    Task task;
+
+                    {
+                        std::lock_guard<std::mutex> lk {state->mtx_};
+                        if (state->tasks_.empty())
+                        {
+                            state->scheduled_ = false;
+                            current = previous;
+                            return;
+                        }
+
+                        task = std::move(state->tasks_.front());
+                        state->tasks_.pop_front();
+                    }
+
+                    task();
+                }
+
+                current = previous;
+
+                // batch exhausted - let other tasks of the executor run first
+                schedule_drain(std::move(state));
+            }
+        };
+
+        std::shared_ptr<State> state_;
+    };
+}
+
+#endif // STRAND_HPP
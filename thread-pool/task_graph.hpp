@@ -0,0 +1,253 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "executor.hpp"
+#include "pool_future.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// graph of tasks with dependency edges executed on an executor (e.g. ThreadPool)
+//  - every node keeps an atomic counter of unfinished predecessors - the
+//    predecessor that brings it to zero makes the node runnable: one ready
+//    successor continues on the same worker, the others are posted
+//  - no worker ever blocks waiting for a predecessor
+//  - the graph is built once and can be run many times; runs of the same
+//    graph must not overlap and the graph must outlive the run
+//  - the first exception thrown by a node is stored in the future of the run;
+//    nodes that did not start yet are skipped
+//  - a node dropped by the executor (e.g. shutdown_now()) fails the run with
+//    std::future_errc::broken_promise
+namespace ver_2_0
+{
+    class TaskGraph
+    {
+    public:
+        using NodeId = size_t;
+
+        TaskGraph() = default;
+
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        template <typename F>
+        NodeId add(F&& f)
+        {
+            check_not_running();
+
+            nodes_.emplace_back(Task {std::forward<F>(f)});
+            validated_ = false;
+            return nodes_.size() - 1;
+        }
+
+        // node before has to finish before node after starts
+        void precede(NodeId before, NodeId after)
+        {
+            check_not_running();
+
+            if (before >= nodes_.size() || after >= nodes_.size() || before == after)
+                throw std::invalid_argument("Invalid dependency");
+
+            nodes_[before].successors.push_back(after);
+            ++nodes_[after].predecessors;
+            validated_ = false;
+        }
+
+        size_t size() const
+        {
+            return nodes_.size();
+        }
+
+        // starts a run - the future is ready when every node finished
+        Future<void> run(Executor& executor)
+        {
+            if (running_.exchange(true, std::memory_order_acquire))
+                throw std::logic_error("Task graph is already running");
+
+            if (!validated_)
+                validate();
+
+            executor_ = &executor;
+            error_ = nullptr;
+            done_ = Promise<void>(nullptr, &executor);
+            Future<void> f_done = done_.get_future();
+
+            if (nodes_.empty())
+            {
+                finish();
+                return f_done;
+            }
+
+            remaining_.store(nodes_.size(), std::memory_order_relaxed);
+            for (auto& node : nodes_)
+                node.pending.store(node.predecessors, std::memory_order_relaxed);
+
+            for (NodeId id : roots_)
+                post_node(id);
+
+            return f_done;
+        }
+
+    private:
+        struct Node
+        {
+            explicit Node(Task work)
+                : work {std::move(work)}
+            {
+            }
+
+            Task work;
+            std::vector<NodeId> successors;
+            size_t predecessors = 0;
+            std::atomic<size_t> pending {0};
+        };
+
+        std::deque<Node> nodes_; // nodes are never moved - std::atomic member
+        std::vector<NodeId> roots_;
+        bool validated_ = false;
+
+        std::atomic<bool> running_ {false};
+        std::atomic<size_t> remaining_ {0};
+        std::atomic<bool> failed_ {false};
+        Executor* executor_ = nullptr;
+        Promise<void> done_;
+        std::mutex mtx_error_;
+        std::exception_ptr error_;
+
+        void check_not_running() const
+        {
+            if (running_.load(std::memory_order_acquire))
+                throw std::logic_error("Task graph cannot be modified while running");
+        }
+
+        // Kahn's algorithm - throws if the graph has a cycle
+        void validate()
+        {
+            std::vector<size_t> in_degree(nodes_.size());
+            std::vector<NodeId> ready;
+
+            roots_.clear();
+            for (NodeId id = 0; id < nodes_.size(); ++id)
+            {
+                in_degree[id] = nodes_[id].predecessors;
+                if (in_degree[id] == 0)
+                    roots_.push_back(id);
+            }
+
+            ready = roots_;
+            size_t visited = 0;
+            while (!ready.empty())
+            {
+                const NodeId id = ready.back();
+                ready.pop_back();
+                ++visited;
+
+                for (NodeId successor : nodes_[id].successors)
+                    if (--in_degree[successor] == 0)
+                        ready.push_back(successor);
+            }
+
+            if (visited != nodes_.size())
+            {
+                running_.store(false, std::memory_order_release);
+                throw std::logic_error("Task graph has a cycle");
+            }
+
+            validated_ = true;
+        }
+
+        void execute(NodeId id)
+        {
+            while (true)
+            {
+                Node& node = nodes_[id];
+
+                if (!failed_.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        node.work();
+                    }
+                    catch (...)
+                    {
+                        set_error(std::current_exception());
+                    }
+                }
+
+                // the first successor that became ready runs next on this thread
+                NodeId next = 0;
+                bool has_next = false;
+                for (NodeId successor : node.successors)
+                {
+                    if (nodes_[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        if (!has_next)
+                        {
+                            next = successor;
+                            has_next = true;
+                        }
+                        else
+                            post_node(successor);
+                    }
+                }
+
+                // once the node is counted off, the graph may be destroyed by another thread -
+                // only locals are used from here on
+                if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    finish();
+                    return;
+                }
+
+                if (!has_next)
+                    return;
+
+                id = next;
+            }
+        }
+
+        void post_node(NodeId id)
+        {
+            executor_->post_internal(detail::DroppableTask {
+                [this, id] { execute(id); },
+                [this, id] {
+                    // the node and the nodes it unblocks are skipped - the run still finishes
+                    set_error(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+                    execute(id);
+                }});
+        }
+
+        void set_error(std::exception_ptr e)
+        {
+            std::lock_guard<std::mutex> lk {mtx_error_};
+            if (!error_)
+                error_ = std::move(e);
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        void finish()
+        {
+            Promise<void> done = std::move(done_);
+            std::exception_ptr error = std::exchange(error_, nullptr);
+            failed_.store(false, std::memory_order_relaxed);
+
+            // the graph may be run again (or destroyed) as soon as the future is ready
+            running_.store(false, std::memory_order_release);
+
+            if (error)
+                done.set_exception(std::move(error));
+            else
+                done.set_value();
+        }
+    };
+}
+
+#endif // TASK_GRAPH_HPP
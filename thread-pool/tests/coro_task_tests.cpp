@@ -0,0 +1,157 @@
+#include <future>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+
+#include "catch.hpp"
+
+#include "coro_task.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+namespace
+{
+    CoroTask<int> answer()
+    {
+        co_return 42;
+    }
+
+    CoroTask<int> add_on(Executor& executor, int x, int y)
+    {
+        co_await executor.schedule();
+        co_return x + y;
+    }
+
+    CoroTask<int> await_future(Future<int> f)
+    {
+        int x = co_await f;
+        int y = co_await answer();
+        co_return x + y;
+    }
+
+    CoroTask<int> fail()
+    {
+        throw runtime_error("error");
+        co_return 0;
+    }
+
+    CoroTask<int> hold(shared_ptr<int> resource, Executor& executor)
+    {
+        co_await executor.schedule();
+        co_return *resource;
+    }
+
+    CoroTask<int> nested_hold(shared_ptr<int> resource, Executor& executor)
+    {
+        co_return co_await hold(resource, executor);
+    }
+
+    // blocks the only worker of the pool until the latch is released
+    void block(ThreadPool& pool, latch& gate)
+    {
+        latch started {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+    }
+}
+
+TEST_CASE("spawn")
+{
+    ThreadPool pool(2);
+
+    SECTION("future gets the result of the coroutine")
+    {
+        REQUIRE(spawn(pool, answer()).get() == 42);
+    }
+
+    SECTION("co_await schedule() continues on the executor")
+    {
+        ThreadPool other(1);
+
+        REQUIRE(spawn(pool, add_on(other, 1, 2)).get() == 3);
+    }
+
+    SECTION("co_await future suspends until it is ready")
+    {
+        Promise<int> promise(nullptr, &pool);
+        auto f = spawn(pool, await_future(promise.get_future()));
+        promise.set_value(1);
+
+        REQUIRE(f.get() == 43);
+    }
+
+    SECTION("exception of the coroutine is passed to the future")
+    {
+        REQUIRE_THROWS_AS(spawn(pool, fail()).get(), runtime_error);
+    }
+}
+
+TEST_CASE("spawn - full and stopped executors")
+{
+    SECTION("spawn throws if the executor refuses the coroutine")
+    {
+        ThreadPool pool(1, size_t {1}, OverflowPolicy::fail);
+        latch gate {1};
+        block(pool, gate);
+        pool.post([] {});
+
+        auto resource = make_shared<int>(1);
+        REQUIRE_THROWS_AS(spawn(pool, hold(resource, pool)), QueueFullError);
+        REQUIRE(resource.use_count() == 1);
+
+        gate.count_down();
+    }
+
+    SECTION("schedule() on a full executor throws inside the coroutine")
+    {
+        ThreadPool pool(1);
+        ThreadPool full(1, size_t {1}, OverflowPolicy::fail);
+        latch gate {1};
+        block(full, gate);
+        full.post([] {});
+
+        REQUIRE_THROWS_AS(spawn(pool, add_on(full, 1, 2)).get(), QueueFullError);
+
+        gate.count_down();
+    }
+
+    SECTION("coroutine dropped before it started is destroyed")
+    {
+        ThreadPool pool(1);
+        latch gate {1};
+        block(pool, gate);
+
+        auto resource = make_shared<int>(1);
+        auto f = spawn(pool, hold(resource, pool));
+        pool.shutdown_now();
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE(resource.use_count() == 1);
+        REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+
+    SECTION("coroutine chain whose resumption is dropped is destroyed")
+    {
+        ThreadPool pool(1);
+        ThreadPool other(1);
+        latch gate {1};
+        block(other, gate);
+
+        auto resource = make_shared<int>(1);
+        auto f = spawn(pool, nested_hold(resource, other));
+
+        pool.submit([] {}).get(); // the coroutine has run up to co_await other.schedule()
+        other.shutdown_now();     // discards the queued resumption
+        gate.count_down();
+        other.shutdown();
+
+        REQUIRE_THROWS_AS(f.get(), future_error);
+        REQUIRE(resource.use_count() == 1);
+    }
+}
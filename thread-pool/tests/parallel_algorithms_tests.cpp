@@ -0,0 +1,100 @@
+#include <atomic>
+#include <future>
+#include <latch>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "parallel_algorithms.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+TEST_CASE("parallel algorithms")
+{
+    ThreadPool pool(4);
+
+    SECTION("parallel_for calls f for every index exactly once")
+    {
+        vector<atomic<int>> calls(10'000);
+
+        parallel_for(pool, 0, 10'000, [&calls](int i) { ++calls[i]; });
+
+        for (auto& c : calls)
+            REQUIRE(c == 1);
+    }
+
+    SECTION("parallel_reduce combines the partial results")
+    {
+        auto sum = parallel_reduce(
+            pool, 1, 10'001, 0L,
+            [](int b, int e) {
+                long partial = 0;
+                for (int i = b; i != e; ++i)
+                    partial += i;
+                return partial;
+            },
+            [](long a, long b) { return a + b; });
+
+        REQUIRE(sum == 50'005'000L);
+    }
+
+    SECTION("parallel_transform writes every result")
+    {
+        vector<int> input(1'000);
+        iota(input.begin(), input.end(), 0);
+        vector<int> output(1'000);
+
+        auto end = parallel_transform(pool, input.begin(), input.end(), output.begin(), [](int x) { return x * 2; });
+
+        REQUIRE(end == output.end());
+        for (int i = 0; i < 1'000; ++i)
+            REQUIRE(output[i] == 2 * i);
+    }
+
+    SECTION("exception of f is rethrown to the caller")
+    {
+        REQUIRE_THROWS_AS(parallel_for(pool, 0, 1'000, [](int i) {
+            if (i == 500)
+                throw runtime_error("error");
+        }), runtime_error);
+    }
+
+    SECTION("may be nested inside a task of the pool")
+    {
+        auto f = pool.submit([&pool] {
+            atomic<int> counter {0};
+            parallel_for(pool, 0, 1'000, [&counter](int) { ++counter; }, 10);
+            return counter.load();
+        });
+
+        REQUIRE(f.get() == 1'000);
+    }
+}
+
+TEST_CASE("parallel algorithms - dropped halves")
+{
+    SECTION("half discarded by shutdown_now makes parallel_for throw broken_promise")
+    {
+        ThreadPool pool(1);
+        latch started {1};
+        latch gate {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+
+        // the halves are queued behind the blocker - index 0 runs on this thread first
+        REQUIRE_THROWS_AS(parallel_for(pool, 0, 8, [&](int i) {
+            if (i == 0)
+            {
+                pool.shutdown_now();
+                gate.count_down();
+            }
+        }, 1), future_error);
+    }
+}
@@ -0,0 +1,284 @@
+#include <chrono>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+TEST_CASE("Future::then")
+{
+    ThreadPool pool(2);
+
+    SECTION("continuation gets the value of the antecedent")
+    {
+        auto f = pool.submit([] { return 6; }).then([](int x) { return x * 7; });
+
+        REQUIRE(f.get() == 42);
+    }
+
+    SECTION("continuations can be chained")
+    {
+        auto f = pool.submit([] { return 7; })
+                     .then([](int x) { return x * x; })
+                     .then([](int x) { return to_string(x + 1); });
+
+        REQUIRE(f.get() == "50");
+    }
+
+    SECTION("continuation of a void future takes no arguments")
+    {
+        auto f = pool.submit([] {}).then([] { return 1; });
+
+        REQUIRE(f.get() == 1);
+    }
+
+    SECTION("the antecedent future is consumed")
+    {
+        auto f = pool.submit([] { return 1; });
+        auto g = f.then([](int x) { return x; });
+
+        REQUIRE(f.valid() == false);
+        REQUIRE(g.get() == 1);
+    }
+
+    SECTION("continuation attached to a ready future runs as well")
+    {
+        Promise<int> promise(nullptr, &pool);
+        auto f = promise.get_future();
+        promise.set_value(1);
+
+        REQUIRE(f.then([](int x) { return x + 1; }).get() == 2);
+    }
+
+    SECTION("exception skips the continuation and is passed to the result")
+    {
+        bool called = false;
+        auto f = pool.submit([]() -> int { throw runtime_error("error"); }).then([&called](int x) {
+            called = true;
+            return x;
+        });
+
+        REQUIRE_THROWS_AS(f.get(), runtime_error);
+        REQUIRE(called == false);
+    }
+
+    SECTION("exception thrown by the continuation is passed to the result")
+    {
+        auto f = pool.submit([] { return 1; }).then([](int) -> int { throw runtime_error("error"); });
+
+        REQUIRE_THROWS_AS(f.get(), runtime_error);
+    }
+
+    SECTION("calling then on an empty future throws no_state")
+    {
+        Future<int> f;
+
+        REQUIRE_THROWS_AS(f.then([](int x) { return x; }), future_error);
+    }
+}
+
+TEST_CASE("Future::then - dropped continuations")
+{
+    SECTION("continuation discarded by shutdown_now reports broken_promise")
+    {
+        ThreadPool pool(1);
+        latch gate{1};
+        auto blocker = pool.submit([&gate] { gate.wait(); });
+
+        Promise<int> promise(nullptr, &pool);
+        auto f = promise.get_future().then([](int x) { return x; });
+        promise.set_value(1); // the continuation is queued behind the blocker
+
+        pool.shutdown_now();
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE(f.is_ready());
+        REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+
+    SECTION("continuation posted after the workers exited reports broken_promise")
+    {
+        ThreadPool pool(1);
+        Promise<int> promise(nullptr, &pool);
+        auto f = promise.get_future().then([](int x) { return x; });
+
+        pool.shutdown();
+        promise.set_value(1);
+
+        REQUIRE(f.is_ready());
+        REQUIRE_THROWS_AS(f.get(), future_error);
+    }
+}
+
+TEST_CASE("when_all")
+{
+    ThreadPool pool(2);
+
+    SECTION("is ready when every input is ready")
+    {
+        vector<Future<int>> futures;
+        for (int i = 0; i < 10; ++i)
+            futures.push_back(pool.submit([i] { return i; }));
+
+        auto results = when_all(move(futures)).get();
+
+        REQUIRE(results.size() == 10);
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(results[i].is_ready());
+            REQUIRE(results[i].get() == i);
+        }
+    }
+
+    SECTION("empty input gives a ready future")
+    {
+        auto f = when_all(vector<Future<int>>{});
+
+        REQUIRE(f.get().empty());
+    }
+
+    SECTION("exception of an input stays in its future")
+    {
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([] { return 1; }));
+        futures.push_back(pool.submit([]() -> int { throw runtime_error("error"); }));
+
+        auto results = when_all(futures.begin(), futures.end()).get();
+
+        REQUIRE(results[0].get() == 1);
+        REQUIRE_THROWS_AS(results[1].get(), runtime_error);
+    }
+}
+
+TEST_CASE("when_any")
+{
+    ThreadPool pool(2);
+
+    SECTION("is ready when the first input is ready")
+    {
+        Promise<int> slow(nullptr, &pool);
+        vector<Future<int>> futures;
+        futures.push_back(slow.get_future());
+        futures.push_back(pool.submit([] { return 2; }));
+
+        auto [index, results] = when_any(move(futures)).get();
+
+        REQUIRE(index == 1);
+        REQUIRE(results[1].get() == 2);
+        REQUIRE(results[0].is_ready() == false);
+
+        slow.set_value(1);
+        REQUIRE(results[0].get() == 1);
+    }
+
+    SECTION("empty input gives index -1")
+    {
+        auto result = when_any(vector<Future<int>>{}).get();
+
+        REQUIRE(result.index == static_cast<size_t>(-1));
+    }
+}
+
+TEST_CASE("CompletionQueue")
+{
+    ThreadPool pool(2);
+
+    SECTION("hands out every future exactly once in completion order")
+    {
+        Promise<int> first(nullptr, &pool);
+        Promise<int> second(nullptr, &pool);
+        vector<Future<int>> futures;
+        futures.push_back(first.get_future());
+        futures.push_back(second.get_future());
+        futures.push_back(pool.submit([] { return 3; }));
+
+        CompletionQueue completed{move(futures)};
+        REQUIRE(completed.size() == 3);
+
+        auto [index_1, f_1] = completed.next();
+        REQUIRE(index_1 == 2);
+        REQUIRE(f_1.get() == 3);
+
+        second.set_value(2);
+        auto [index_2, f_2] = completed.next();
+        REQUIRE(index_2 == 1);
+        REQUIRE(f_2.get() == 2);
+
+        first.set_value(1);
+        auto [index_3, f_3] = completed.next();
+        REQUIRE(index_3 == 0);
+        REQUIRE(f_3.get() == 1);
+
+        REQUIRE(completed.empty());
+        REQUIRE_THROWS_AS(completed.next(), out_of_range);
+    }
+
+    SECTION("exceptions and broken promises are handed out like values")
+    {
+        vector<Future<int>> futures;
+        futures.push_back(pool.submit([]() -> int { throw runtime_error("error"); }));
+        {
+            Promise<int> broken(nullptr, &pool);
+            futures.push_back(broken.get_future());
+        }
+
+        CompletionQueue<int> completed{futures.begin(), futures.end()};
+
+        int errors = 0;
+        while (!completed.empty())
+        {
+            try
+            {
+                completed.next().future.get();
+            }
+            catch (const exception&)
+            {
+                ++errors;
+            }
+        }
+
+        REQUIRE(errors == 2);
+    }
+
+    SECTION("many futures")
+    {
+        const int count = 10'000;
+        vector<Future<int>> futures;
+        for (int i = 0; i < count; ++i)
+            futures.push_back(pool.submit([i] { return i; }));
+
+        CompletionQueue completed{move(futures)};
+        vector<bool> seen(count);
+        long sum = 0;
+        while (!completed.empty())
+        {
+            auto [index, f] = completed.next();
+            REQUIRE_FALSE(seen[index]);
+            seen[index] = true;
+            sum += f.get();
+        }
+
+        REQUIRE(sum == long(count) * (count - 1) / 2);
+    }
+
+    SECTION("may be destroyed with futures pending")
+    {
+        Promise<int> pending(nullptr, &pool);
+        {
+            vector<Future<int>> futures;
+            futures.push_back(pending.get_future());
+            CompletionQueue completed{move(futures)};
+        }
+
+        pending.set_value(1);
+    }
+}
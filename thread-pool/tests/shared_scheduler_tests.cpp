@@ -0,0 +1,138 @@
+#include <atomic>
+#include <future>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "shared_scheduler.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+namespace
+{
+    // blocks the only worker of the scheduler (through view) until the latch is released
+    void block(PoolView& view, latch& gate)
+    {
+        latch started {1};
+        view.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+    }
+}
+
+TEST_CASE("PoolView")
+{
+    SharedScheduler scheduler {4};
+
+    SECTION("future gets the result or the exception of the task")
+    {
+        PoolView view {scheduler};
+
+        REQUIRE(view.submit([] { return 42; }).get() == 42);
+        REQUIRE_THROWS_AS(view.submit([]() -> int { throw runtime_error("error"); }).get(), runtime_error);
+    }
+
+    SECTION("tasks of one view start in FIFO order")
+    {
+        SharedScheduler single {1};
+        PoolView view {single};
+        vector<int> order;
+        for (int i = 0; i < 100; ++i)
+            view.post([&order, i] { order.push_back(i); });
+
+        view.shutdown();
+
+        REQUIRE(order.size() == 100);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(order[i] == i);
+    }
+
+    SECTION("max_threads limits the tasks of the view running at the same time")
+    {
+        PoolView view {scheduler, PoolViewOptions {.max_threads = 1}};
+        atomic<int> active {0};
+        atomic<int> max_active {0};
+
+        vector<Future<void>> results;
+        for (int i = 0; i < 50; ++i)
+            results.push_back(view.submit([&] {
+                const int now = ++active;
+                int seen = max_active.load();
+                while (now > seen && !max_active.compare_exchange_weak(seen, now))
+                    ;
+                this_thread::yield();
+                --active;
+            }));
+
+        for (auto& f : results)
+            f.get();
+
+        REQUIRE(max_active == 1);
+        REQUIRE(view.stats().executed == 50);
+    }
+
+    SECTION("task may wait for a task of the same view on a single worker")
+    {
+        SharedScheduler single {1};
+        PoolView view {single};
+
+        auto f = view.submit([&view] { return view.submit([] { return 1; }).get() + 1; });
+
+        REQUIRE(f.get() == 2);
+    }
+
+    SECTION("weight must be positive")
+    {
+        REQUIRE_THROWS_AS((PoolView {scheduler, PoolViewOptions {.weight = 0}}), invalid_argument);
+    }
+}
+
+TEST_CASE("PoolView - shutdown")
+{
+    SharedScheduler scheduler {1};
+
+    SECTION("drain runs the queued tasks first")
+    {
+        PoolView view {scheduler};
+        atomic<int> counter {0};
+        for (int i = 0; i < 10; ++i)
+            view.post([&counter] { ++counter; });
+
+        view.shutdown();
+
+        REQUIRE(counter == 10);
+    }
+
+    SECTION("abort discards the queued tasks of the view only")
+    {
+        PoolView blocker {scheduler};
+        PoolView aborted {scheduler};
+        PoolView other {scheduler};
+        latch gate {1};
+        block(blocker, gate);
+
+        auto dropped = aborted.submit([] { return 1; });
+        auto kept = other.submit([] { return 2; });
+
+        aborted.shutdown(ShutdownMode::abort);
+        gate.count_down();
+
+        REQUIRE_THROWS_AS(dropped.get(), future_error);
+        REQUIRE(kept.get() == 2);
+        REQUIRE(aborted.stats().queued == 0);
+    }
+
+    SECTION("tasks posted after shutdown report broken_promise")
+    {
+        PoolView view {scheduler};
+        view.shutdown();
+
+        REQUIRE_THROWS_AS(view.submit([] { return 1; }).get(), future_error);
+    }
+}
@@ -0,0 +1,152 @@
+#include <atomic>
+#include <deque>
+#include <future>
+#include <latch>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "strand.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+namespace
+{
+    // keeps posted tasks until they are run or dropped by the test
+    class ManualExecutor : public Executor
+    {
+    public:
+        void post(Task task) override
+        {
+            tasks_.push_back(move(task));
+        }
+
+        void run_all()
+        {
+            while (!tasks_.empty())
+            {
+                Task task = move(tasks_.front());
+                tasks_.pop_front();
+                task();
+            }
+        }
+
+        void drop_all()
+        {
+            tasks_.clear();
+        }
+
+    private:
+        deque<Task> tasks_;
+    };
+}
+
+TEST_CASE("Strand")
+{
+    ThreadPool pool(4);
+
+    SECTION("runs tasks in FIFO order")
+    {
+        Strand strand {pool};
+        vector<int> order;
+        for (int i = 0; i < 1'000; ++i)
+            strand.post([&order, i] { order.push_back(i); });
+
+        strand.submit([] {}).get();
+
+        REQUIRE(order.size() == 1'000);
+        for (int i = 0; i < 1'000; ++i)
+            REQUIRE(order[i] == i);
+    }
+
+    SECTION("runs one task at a time")
+    {
+        Strand strand {pool, 8};
+        atomic<int> active {0};
+        atomic<bool> overlapped {false};
+        int counter = 0; // no lock - touched by the strand only
+
+        vector<Future<void>> results;
+        for (int i = 0; i < 1'000; ++i)
+            results.push_back(strand.submit([&] {
+                if (++active > 1)
+                    overlapped = true;
+                ++counter;
+                --active;
+            }));
+
+        for (auto& f : results)
+            f.get();
+
+        REQUIRE(overlapped == false);
+        REQUIRE(counter == 1'000);
+    }
+
+    SECTION("running_in_this_thread is true for tasks of the strand only")
+    {
+        Strand strand {pool};
+
+        REQUIRE(strand.running_in_this_thread() == false);
+        REQUIRE(strand.submit([&strand] { return strand.running_in_this_thread(); }).get());
+        REQUIRE(pool.submit([&strand] { return strand.running_in_this_thread(); }).get() == false);
+    }
+
+    SECTION("exception of a task is passed to its future")
+    {
+        Strand strand {pool};
+
+        REQUIRE_THROWS_AS(strand.submit([]() -> int { throw runtime_error("error"); }).get(), runtime_error);
+        REQUIRE(strand.submit([] { return 1; }).get() == 1);
+    }
+
+    SECTION("batch size must be positive")
+    {
+        REQUIRE_THROWS_AS((Strand {pool, 0}), invalid_argument);
+    }
+}
+
+TEST_CASE("Strand - dropped drain")
+{
+    SECTION("tasks queued behind a drain discarded by shutdown_now report broken_promise")
+    {
+        ThreadPool pool(1);
+        latch started {1};
+        latch gate {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+
+        Strand strand {pool};
+        auto f1 = strand.submit([] { return 1; });
+        auto f2 = strand.submit([] { return 2; });
+
+        pool.shutdown_now();
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE_THROWS_AS(f1.get(), future_error);
+        REQUIRE_THROWS_AS(f2.get(), future_error);
+    }
+
+    SECTION("tasks posted after a dropped drain are scheduled again")
+    {
+        ManualExecutor executor;
+        Strand strand {executor};
+
+        auto dropped = strand.submit([] { return 1; });
+        executor.drop_all();
+
+        REQUIRE_THROWS_AS(dropped.get(), future_error);
+
+        bool called = false;
+        strand.post([&called] { called = true; });
+        executor.run_all();
+
+        REQUIRE(called);
+    }
+}
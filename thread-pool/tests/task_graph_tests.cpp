@@ -0,0 +1,160 @@
+#include <atomic>
+#include <future>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "task_graph.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+TEST_CASE("TaskGraph")
+{
+    ThreadPool pool(4);
+
+    SECTION("runs every node after its predecessors")
+    {
+        mutex mtx;
+        vector<int> order;
+        auto log = [&](int id) {
+            return [&, id] {
+                lock_guard lk {mtx};
+                order.push_back(id);
+            };
+        };
+
+        TaskGraph graph;
+        auto a = graph.add(log(0));
+        auto b = graph.add(log(1));
+        auto c = graph.add(log(2));
+        auto d = graph.add(log(3));
+        graph.precede(a, b);
+        graph.precede(a, c);
+        graph.precede(b, d);
+        graph.precede(c, d);
+
+        graph.run(pool).get();
+
+        REQUIRE(order.size() == 4);
+        REQUIRE(order.front() == 0);
+        REQUIRE(order.back() == 3);
+    }
+
+    SECTION("empty graph is done at once")
+    {
+        TaskGraph graph;
+
+        graph.run(pool).get();
+    }
+
+    SECTION("can be run many times")
+    {
+        atomic<int> counter {0};
+        TaskGraph graph;
+        auto first = graph.add([&counter] { ++counter; });
+        for (int i = 0; i < 10; ++i)
+            graph.precede(first, graph.add([&counter] { ++counter; }));
+
+        for (int i = 0; i < 10; ++i)
+            graph.run(pool).get();
+
+        REQUIRE(counter == 110);
+    }
+
+    SECTION("running graph cannot be run again nor modified")
+    {
+        latch gate {1};
+        TaskGraph graph;
+        graph.add([&gate] { gate.wait(); });
+
+        auto f = graph.run(pool);
+
+        REQUIRE_THROWS_AS(graph.run(pool), logic_error);
+        REQUIRE_THROWS_AS(graph.add([] {}), logic_error);
+
+        gate.count_down();
+        f.get();
+    }
+
+    SECTION("cycle is detected")
+    {
+        TaskGraph graph;
+        auto a = graph.add([] {});
+        auto b = graph.add([] {});
+        graph.precede(a, b);
+        graph.precede(b, a);
+
+        REQUIRE_THROWS_AS(graph.run(pool), logic_error);
+        REQUIRE_THROWS_AS(graph.precede(a, a), invalid_argument);
+    }
+
+    SECTION("exception is passed to the future and later nodes are skipped")
+    {
+        bool called = false;
+        bool fail = true;
+        TaskGraph graph;
+        auto a = graph.add([&fail] {
+            if (exchange(fail, false))
+                throw runtime_error("error");
+        });
+        auto b = graph.add([&called] { called = true; });
+        graph.precede(a, b);
+
+        REQUIRE_THROWS_AS(graph.run(pool).get(), runtime_error);
+        REQUIRE(called == false);
+
+        graph.run(pool).get(); // the error does not stick to the next run
+        REQUIRE(called == true);
+    }
+
+    SECTION("graph may be destroyed as soon as its run is done")
+    {
+        for (int i = 0; i < 1'000; ++i)
+        {
+            auto graph = make_unique<TaskGraph>();
+            auto root = graph->add([] {});
+            for (int j = 0; j < 4; ++j)
+                graph->precede(root, graph->add([] {}));
+
+            graph->run(pool).get();
+        }
+    }
+}
+
+TEST_CASE("TaskGraph - dropped nodes")
+{
+    SECTION("nodes discarded by shutdown_now fail the run with broken_promise")
+    {
+        ThreadPool pool(1);
+        latch started {1};
+        latch gate {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+
+        bool called = false;
+        TaskGraph graph;
+        auto a = graph.add([] {});
+        auto b = graph.add([] {});
+        auto c = graph.add([&called] { called = true; });
+        graph.precede(a, c);
+        graph.precede(b, c);
+
+        auto f = graph.run(pool); // both roots are queued behind the blocker
+        pool.shutdown_now();
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE_THROWS_AS(f.get(), future_error);
+        REQUIRE(called == false);
+    }
+}
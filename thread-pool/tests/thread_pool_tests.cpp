@@ -0,0 +1,180 @@
+#include <atomic>
+#include <functional>
+#include <future>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include "strand.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+TEST_CASE("ThreadPool - bounded queue")
+{
+    SECTION("drop_oldest drops submitted tasks but never internal ones")
+    {
+        ThreadPool pool(1, size_t {2}, OverflowPolicy::drop_oldest);
+        latch started {1};
+        latch gate {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+
+        Strand strand {pool};
+        auto f = strand.submit([] { return 1; }); // the drain task is posted with post_internal()
+
+        atomic<int> counter {0};
+        for (int i = 0; i < 4; ++i)
+            pool.post([&counter] { ++counter; });
+
+        gate.count_down();
+
+        REQUIRE(f.get() == 1);
+        pool.shutdown();
+        REQUIRE(counter == 2);
+    }
+}
+
+TEST_CASE("ThreadPool - metrics after shutdown")
+{
+    SECTION("tasks discarded by an abort shutdown leave the queue depth")
+    {
+        ThreadPool pool(1);
+        latch started {1};
+        latch gate {1};
+        pool.post([&] {
+            started.count_down();
+            gate.wait();
+        });
+        started.wait();
+        pool.enable_metrics();
+
+        for (int i = 0; i < 10; ++i)
+            pool.post([] {});
+        const size_t depth = pool.metrics().queue_depth;
+
+        pool.shutdown_now();
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE(depth == 10);
+        REQUIRE(pool.metrics().queue_depth == 0);
+    }
+
+    SECTION("tasks discarded after the workers exited leave the queue depth")
+    {
+        ThreadPool pool(1);
+        pool.enable_metrics();
+        pool.shutdown();
+
+        auto f = pool.submit([] { return 1; });
+        pool.post([] {});
+
+        REQUIRE_THROWS_AS(f.get(), future_error);
+        REQUIRE(pool.metrics().queue_depth == 0);
+    }
+}
+
+TEST_CASE("ThreadPool - LIFO slot")
+{
+    SECTION("task submitted by a worker runs next on the same thread")
+    {
+        ThreadPool pool(2);
+        pool.enable_lifo_slot();
+
+        auto f = pool.submit([&pool] {
+            const auto outer = this_thread::get_id();
+            return pool.submit([] { return this_thread::get_id(); }).then([outer](thread::id inner) { return inner == outer; });
+        });
+
+        REQUIRE(f.get().get());
+    }
+
+    SECTION("task in the slot runs before older tasks of the shared queue")
+    {
+        ThreadPool pool(1);
+        pool.enable_lifo_slot();
+        vector<string> order; // touched by the only worker
+        latch gate {1};
+
+        pool.post([&] {
+            gate.wait();
+            pool.post([&order] { order.push_back("slot"); });
+        });
+        pool.post([&order] { order.push_back("queued"); });
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE(order == vector<string> {"slot", "queued"});
+    }
+
+    SECTION("chain of follow-ups is spilled and does not starve the shared queue")
+    {
+        ThreadPool pool(1);
+        pool.enable_lifo_slot();
+        const int chain_length = 100;
+        int step = 0;
+        int queued_at = -1;
+        latch gate {1};
+        latch chain_done {1};
+
+        function<void()> next = [&] {
+            if (++step < chain_length)
+                pool.post(next);
+            else
+                chain_done.count_down();
+        };
+        pool.post([&] {
+            gate.wait();
+            pool.post(next);
+        });
+        pool.post([&] { queued_at = step; });
+        gate.count_down();
+        chain_done.wait(); // the slot is not spilled once the pool is stopping
+        pool.shutdown();
+
+        REQUIRE(step == chain_length);
+        REQUIRE(queued_at >= 0);
+        REQUIRE(queued_at < chain_length);
+    }
+
+    SECTION("task left in the slot by shutdown_now reports broken_promise")
+    {
+        ThreadPool pool(1);
+        pool.enable_lifo_slot();
+        Future<int> in_slot;
+
+        pool.submit([&] {
+                in_slot = pool.submit([] { return 1; });
+                pool.shutdown_now();
+            }).get();
+        pool.shutdown();
+
+        REQUIRE_THROWS_AS(in_slot.get(), future_error);
+    }
+
+    SECTION("slot is not used while disabled")
+    {
+        ThreadPool pool(1);
+        vector<string> order;
+        latch gate {1};
+
+        pool.post([&] {
+            gate.wait();
+            pool.post([&order] { order.push_back("posted by worker"); });
+        });
+        pool.post([&order] { order.push_back("queued"); });
+        gate.count_down();
+        pool.shutdown();
+
+        REQUIRE(pool.lifo_slot_enabled() == false);
+        REQUIRE(order == vector<string> {"queued", "posted by worker"});
+    }
+}
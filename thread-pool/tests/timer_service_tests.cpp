@@ -0,0 +1,159 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include "catch.hpp"
+
+#include "thread_pool.hpp"
+#include "timer_service.hpp"
+
+using namespace std;
+using namespace ver_2_0;
+
+namespace
+{
+    // runs tasks on the posting thread - an exception of a task is counted
+    class InlineExecutor : public Executor
+    {
+    public:
+        atomic<int> errors {0};
+        atomic<int> dropped {0};
+        atomic<int> drop_next {0};
+
+        void post(Task task) override
+        {
+            if (drop_next > 0)
+            {
+                --drop_next;
+                ++dropped;
+                return; // the task is destroyed without running
+            }
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                ++errors;
+            }
+        }
+    };
+
+    template <typename Predicate>
+    bool wait_for(Predicate predicate, chrono::milliseconds timeout = 5s)
+    {
+        const auto deadline = chrono::steady_clock::now() + timeout;
+        while (!predicate())
+        {
+            if (chrono::steady_clock::now() > deadline)
+                return false;
+            this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+}
+
+TEST_CASE("TimerService")
+{
+    ThreadPool pool(2);
+    TimerService timers {pool};
+
+    SECTION("post_after runs the task on the executor after the delay")
+    {
+        promise<chrono::steady_clock::time_point> fired;
+        auto f = fired.get_future();
+        const auto start = chrono::steady_clock::now();
+
+        timers.post_after(20ms, [&fired] { fired.set_value(chrono::steady_clock::now()); });
+
+        REQUIRE(f.get() - start >= 20ms);
+    }
+
+    SECTION("post_at runs the task at the time point")
+    {
+        promise<void> fired;
+        auto f = fired.get_future();
+
+        timers.post_at(chrono::steady_clock::now() + 10ms, [&fired] { fired.set_value(); });
+
+        REQUIRE(f.wait_for(5s) == future_status::ready);
+    }
+
+    SECTION("cancelled timer never runs")
+    {
+        atomic<bool> called {false};
+        auto id = timers.post_after(50ms, [&called] { called = true; });
+
+        REQUIRE(timers.cancel(id));
+        REQUIRE(timers.cancel(id) == false);
+        REQUIRE(timers.pending() == 0);
+
+        this_thread::sleep_for(100ms);
+        REQUIRE(called == false);
+    }
+
+    SECTION("post_every runs the task until it is cancelled")
+    {
+        atomic<int> counter {0};
+        auto id = timers.post_every(5ms, [&counter] { ++counter; });
+
+        REQUIRE(wait_for([&] { return counter >= 3; }));
+        REQUIRE(timers.cancel(id));
+    }
+
+    SECTION("empty tasks are rejected")
+    {
+        REQUIRE_THROWS_AS(timers.post_after(1ms, Task {}), invalid_argument);
+        REQUIRE_THROWS_AS(timers.post_every(1ms, Task {}), invalid_argument);
+    }
+}
+
+TEST_CASE("TimerService - failing and dropped runs")
+{
+    InlineExecutor executor;
+
+    SECTION("periodic task that throws still runs at later ticks")
+    {
+        atomic<int> counter {0};
+        {
+            TimerService timers {executor};
+            timers.post_every(5ms, [&counter] {
+                ++counter;
+                throw runtime_error("error");
+            });
+
+            REQUIRE(wait_for([&] { return counter >= 3; }));
+        }
+
+        REQUIRE(executor.errors == counter);
+    }
+
+    SECTION("periodic task whose run is dropped still runs at later ticks")
+    {
+        executor.drop_next = 2;
+        atomic<int> counter {0};
+        {
+            TimerService timers {executor};
+            timers.post_every(5ms, [&counter] { ++counter; });
+
+            REQUIRE(wait_for([&] { return counter >= 3; }));
+        }
+
+        REQUIRE(executor.dropped == 2);
+    }
+
+    SECTION("pending timers are dropped at destruction")
+    {
+        atomic<bool> called {false};
+        {
+            TimerService timers {executor};
+            timers.post_after(1h, [&called] { called = true; });
+            REQUIRE(timers.pending() == 1);
+        }
+
+        REQUIRE(called == false);
+    }
+}
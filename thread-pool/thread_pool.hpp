@@ -0,0 +1,1005 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "cpu_topology.hpp"
+#include "executor.hpp"
+#include "idle_policy.hpp"
+#include "mpmc_queue.hpp"
+#include "numa_task_queue.hpp"
+#include "pool_future.hpp"
+#include "priority_task_queue.hpp"
+#include "thread_pool_metrics.hpp"
+#include "thread_pool_trace.hpp"
+#include "thread_safe_queue.hpp"
+#include "timer_service.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace ver_1_0
+{
+    class ThreadPool
+    {
+    public:
+        ThreadPool(size_t size)
+            : threads_(size)
+        {
+            for (auto& thread : threads_)
+                thread = std::thread([this]
+                    { run(); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // workers drain the queue and exit
+        ~ThreadPool()
+        {
+            tasks_.close();
+
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        void submit(Task task)
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            tasks_.push(std::move(task));
+        }
+
+    private:
+        std::vector<std::thread> threads_;
+        ThreadSafeQueue<Task> tasks_;
+
+        void run()
+        {
+            Task task;
+            while (tasks_.pop(task))
+                task();
+        }
+    };
+}
+
+namespace ver_2_0
+{
+    namespace detail
+    {
+        // queues with sub-queues (lanes, NUMA nodes) declare static constexpr bool is_fifo = false
+        template <typename TQueue, typename = void>
+        struct is_fifo_queue : std::true_type
+        {
+        };
+
+        template <typename TQueue>
+        struct is_fifo_queue<TQueue, std::void_t<decltype(TQueue::is_fifo)>> : std::bool_constant<TQueue::is_fifo>
+        {
+        };
+
+        template <typename TQueue>
+        constexpr bool is_fifo_queue_v = is_fifo_queue<TQueue>::value;
+
+        // queues with close() stop workers at once; others get one stop task per worker
+        template <typename TQueue>
+        concept closable_queue = requires(TQueue& queue) { queue.close(); };
+
+        // pool & index of the worker running on this thread (pool == nullptr - not a pool worker)
+        struct WorkerContext
+        {
+            const void* pool = nullptr;
+            size_t index = 0;
+        };
+
+        inline thread_local WorkerContext current_worker;
+
+        // wraps f into a task that fulfills the returned future
+        template <typename F>
+        auto package_task(SharedStateSlab* slab, Executor* executor, F&& f) -> std::pair<Task, Future<decltype(f())>>
+        {
+            using ResultT = decltype(f());
+            Promise<ResultT> promise(slab, executor);
+            Future<ResultT> f_result = promise.get_future();
+            Task task {[promise = std::move(promise), f = std::forward<F>(f)]() mutable
+                { promise.set_result_of(f); }};
+            return {std::move(task), std::move(f_result)};
+        }
+    }
+
+    enum class ShutdownMode
+    {
+        drain,
+        abort
+    };
+
+    // element of the pool's task queue
+    //  - an empty task stops a worker (queues without close())
+    //  - enqueued_at is set only when metrics are enabled
+    //  - a task whose stop_token is stop_requested() when dequeued is discarded without running
+    //  - trace is stamped only when tracing is compiled in and enabled (empty type otherwise)
+    struct QueuedTask
+    {
+        Task task;
+        std::chrono::steady_clock::time_point enqueued_at {};
+        std::stop_token stop_token {};
+        [[no_unique_address]] TaskTraceStamp trace {};
+    };
+
+    // TaskQueue - ThreadSafeQueue<QueuedTask> or any queue with the same push/pop surface (e.g. BoundedMpmcQueue<QueuedTask>)
+    //  - a queue with close() and bool pop() is closed at shutdown - workers exit as soon as it is
+    //    drained; other queues get one stop task per worker behind the backlog
+    //  - Future::get()/wait() called by a task runs other queued tasks until the
+    //    result is ready (and parks while the queue is empty) - a task must not hold
+    //    a lock that queued tasks may need
+    //  - discarded tasks (cancelled or dropped by shutdown_now()) never run -
+    //    their futures report std::future_errc::broken_promise
+    //  - a bounded ThreadSafeQueue applies its OverflowPolicy to submitted tasks; the pool
+    //    runs a task on the submitting thread if the policy is caller_runs, or if the policy
+    //    is block and the submitter is a worker of the pool (it would wait for itself);
+    //    stop tasks, tasks submitted after shutdown and post_internal() (continuations,
+    //    timers, strands, ...) ignore the capacity and are never dropped by drop_oldest
+    //  - a worker never waits for a full queue without an OverflowPolicy (e.g. BoundedMpmcQueue) -
+    //    a task it submits runs on the worker if the queue is full
+    //  - with the LIFO slot enabled a task posted/submitted by a worker is kept in that
+    //    worker's slot and runs next on the same thread (other workers cannot take it)
+    template <typename TaskQueue>
+    class BasicThreadPool : public Executor
+    {
+    public:
+        template <typename... TQueueArgs>
+        BasicThreadPool(size_t size, TQueueArgs&&... queue_args)
+            : threads_(size)
+            , tasks_(std::forward<TQueueArgs>(queue_args)...)
+            , metrics_(size)
+            , local_slots_(size)
+            , tracer_(size)
+        {
+            running_workers_.store(size);
+
+            for (size_t i = 0; i < threads_.size(); ++i)
+            {
+                threads_[i] = std::thread([this, i]
+                    { run(i); });
+
+                if constexpr (requires { tasks_.worker_cpus(i); })
+                {
+                    if (const auto cpus = tasks_.worker_cpus(i); !cpus.empty())
+                        pin_thread(threads_[i].native_handle(), cpus);
+                }
+            }
+        }
+
+        BasicThreadPool(const BasicThreadPool&) = delete;
+        BasicThreadPool& operator=(const BasicThreadPool&) = delete;
+
+        ~BasicThreadPool()
+        {
+            timers_.reset(); // pending timers are dropped
+
+            shutdown(ShutdownMode::drain);
+        }
+
+        // stops the workers and waits for them - must not be called by a task of the pool
+        //  - drain: queued tasks (and tasks they submit meanwhile) run first
+        //  - abort: queued tasks are discarded, running tasks complete
+        // tasks submitted once all workers have exited never run - their futures report broken_promise
+        void shutdown(ShutdownMode mode = ShutdownMode::drain)
+        {
+            if (detail::current_worker.pool == this)
+                throw std::logic_error("Thread pool cannot be shut down by its own task");
+
+            if (mode == ShutdownMode::abort)
+                abort_backlog();
+            else
+                stop_workers();
+
+            std::call_once(workers_joined_, [this] {
+                for (auto& thread : threads_)
+                    thread.join();
+            });
+        }
+
+        // shutdown(ShutdownMode::abort) without waiting - may be called by a task of the pool
+        //  - the destructor still waits for the running tasks
+        void shutdown_now()
+        {
+            abort_backlog();
+        }
+
+        size_t size() const
+        {
+            return threads_.size();
+        }
+
+        // fire & forget - no future is created
+        void post(Task task) override
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            push(make_queued(std::move(task)));
+        }
+
+        // ignores the capacity of a bounded queue - see Executor::post_internal
+        void post_internal(Task task) override
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            push_internal(make_queued(std::move(task)));
+        }
+
+        template <typename F>
+        auto submit(F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = make_task(std::forward<F>(f));
+            push(make_queued(std::move(task)));
+            return std::move(f_result);
+        }
+
+        // cooperative cancellation - the task is skipped if stop is requested before
+        // it starts; f invocable with std::stop_token gets the token to poll while running
+        template <typename F>
+        auto submit(std::stop_token stop_token, F&& f)
+        {
+            if constexpr (std::is_invocable_v<F&, std::stop_token>)
+            {
+                auto [task, f_result] = make_task([f = std::forward<F>(f), stop_token]() mutable { return f(stop_token); });
+                push(make_queued(std::move(task), std::move(stop_token)));
+                return std::move(f_result);
+            }
+            else
+            {
+                auto [task, f_result] = make_task(std::forward<F>(f));
+                push(make_queued(std::move(task), std::move(stop_token)));
+                return std::move(f_result);
+            }
+        }
+
+        // requires a queue with priority lanes (e.g. PriorityTaskQueue<Task>)
+        template <typename F>
+        auto submit(TaskPriority priority, F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = make_task(std::forward<F>(f));
+            QueuedTask item = make_queued(std::move(task));
+
+            // the priority does not matter once the pool is stopping
+            if (stopping_.load(std::memory_order_relaxed))
+                push_while_stopping(std::move(item));
+            else
+            {
+                tasks_.push(std::move(item), priority);
+                parked_helpers_.wake_all();
+            }
+
+            return std::move(f_result);
+        }
+
+        // submits every callable from [first, last) with a single queue operation
+        template <typename InputIt>
+        auto submit_bulk(InputIt first, InputIt last) -> std::vector<Future<decltype((*first)())>>
+        {
+            using ResultT = decltype((*first)());
+
+            std::vector<Future<ResultT>> f_results;
+            std::vector<QueuedTask> tasks;
+
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+            {
+                const auto count = static_cast<size_t>(std::distance(first, last));
+                f_results.reserve(count);
+                tasks.reserve(count);
+            }
+
+            for (; first != last; ++first)
+            {
+                auto [task, f_result] = make_task(*first);
+                tasks.push_back(make_queued(std::move(task)));
+                f_results.push_back(std::move(f_result));
+            }
+
+            push_range(tasks);
+
+            return f_results;
+        }
+
+        // submits f(0), f(1), ..., f(count - 1) with a single queue operation
+        template <typename F>
+        auto submit_n(size_t count, F f) -> std::vector<Future<decltype(f(size_t {}))>>
+        {
+            using ResultT = decltype(f(size_t {}));
+
+            std::vector<Future<ResultT>> f_results;
+            std::vector<QueuedTask> tasks;
+            f_results.reserve(count);
+            tasks.reserve(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto [task, f_result] = make_task([f, i]() mutable { return f(i); });
+                tasks.push_back(make_queued(std::move(task)));
+                f_results.push_back(std::move(f_result));
+            }
+
+            push_range(tasks);
+
+            return f_results;
+        }
+
+        // delayed & periodic tasks - a single timer thread (started on first use)
+        // hands them over to the pool when due, no worker waits meanwhile
+        template <typename F>
+        auto submit_after(std::chrono::steady_clock::duration delay, F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = make_task(std::forward<F>(f));
+            timers().post_after(delay, std::move(task));
+            return std::move(f_result);
+        }
+
+        template <typename F>
+        auto submit_at(std::chrono::steady_clock::time_point time, F&& f) -> Future<decltype(f())>
+        {
+            auto [task, f_result] = make_task(std::forward<F>(f));
+            timers().post_at(time, std::move(task));
+            return std::move(f_result);
+        }
+
+        // runs every period until cancel_timer(id) - a run is skipped if the previous one is still running
+        TimerId submit_every(std::chrono::steady_clock::duration period, Task task)
+        {
+            return timers().post_every(period, std::move(task));
+        }
+
+        // cancellable fire & forget versions of submit_after/submit_at
+        TimerId post_after(std::chrono::steady_clock::duration delay, Task task)
+        {
+            return timers().post_after(delay, std::move(task));
+        }
+
+        TimerId post_at(std::chrono::steady_clock::time_point time, Task task)
+        {
+            return timers().post_at(time, std::move(task));
+        }
+
+        // O(1) - false if the timer already fired or was cancelled
+        bool cancel_timer(TimerId id)
+        {
+            return timers().cancel(id);
+        }
+
+        // starts recording per-worker metrics (queue wait, run time, busy/idle time)
+        void enable_metrics()
+        {
+            if constexpr (requires { tasks_.dropped_count(); })
+            {
+                if (!metrics_enabled())
+                    dropped_before_metrics_.store(tasks_.dropped_count(), std::memory_order_relaxed);
+            }
+
+            metrics_enabled_.store(true, std::memory_order_relaxed);
+        }
+
+        bool metrics_enabled() const
+        {
+            return metrics_enabled_.load(std::memory_order_relaxed);
+        }
+
+        PoolMetricsSnapshot metrics() const
+        {
+            PoolMetricsSnapshot result = metrics_.snapshot();
+
+            // tasks dropped by a bounded queue never reach a worker
+            if constexpr (requires { tasks_.dropped_count(); })
+            {
+                const size_t dropped = tasks_.dropped_count() - dropped_before_metrics_.load(std::memory_order_relaxed);
+                result.queue_depth = result.queue_depth > dropped ? result.queue_depth - dropped : 0;
+            }
+
+            return result;
+        }
+
+        // records submit/start/end of every task submitted from now on into per-worker buffers
+        // of events_per_worker events - requires THREAD_POOL_TRACING, a no-op otherwise
+        //  - tasks run on the submitting thread (OverflowPolicy::caller_runs) are not traced
+        void enable_tracing(size_t events_per_worker = 1 << 16)
+        {
+            if constexpr (tracing_compiled_in)
+                tracer_.enable(events_per_worker);
+        }
+
+        void disable_tracing()
+        {
+            tracer_.disable();
+        }
+
+        bool tracing_enabled() const
+        {
+            return tracing_compiled_in && tracer_.enabled();
+        }
+
+        // Chrome Trace Event JSON - open in ui.perfetto.dev or chrome://tracing
+        void write_trace(std::ostream& out) const
+        {
+            tracer_.write_chrome_trace(out, "thread pool");
+        }
+
+        // events lost because a worker's buffer was full
+        size_t dropped_trace_events() const
+        {
+            return tracer_.dropped_events();
+        }
+
+        // require a queue that tracks them (e.g. ThreadSafeQueue)
+        size_t queue_high_water_mark() const
+        {
+            return tasks_.high_water_mark();
+        }
+
+        size_t dropped_task_count() const
+        {
+            return tasks_.dropped_count();
+        }
+
+        // tasks posted/submitted from a worker of this pool run next on the same worker
+        // (warm caches, no shared queue traffic) - the slot holds one task, further tasks
+        // go to the shared queue; after max_lifo_streak slot tasks in a row the slot is
+        // spilled to the shared queue, so a chain of follow-ups cannot starve it
+        //  - a task in the slot waits for the current task of its worker to finish -
+        //    do not enable for tasks that submit work and then run for long
+        void enable_lifo_slot()
+        {
+            lifo_slot_enabled_.store(true, std::memory_order_relaxed);
+        }
+
+        bool lifo_slot_enabled() const
+        {
+            return lifo_slot_enabled_.load(std::memory_order_relaxed);
+        }
+
+        // takes effect the next time a worker runs out of tasks
+        void set_idle_policy(IdlePolicy policy)
+        {
+            spin_count_.store(policy.spin_count, std::memory_order_relaxed);
+            yield_count_.store(policy.yield_count, std::memory_order_relaxed);
+            max_spinners_.store(policy.max_spinners, std::memory_order_relaxed);
+        }
+
+        IdlePolicy idle_policy() const
+        {
+            return IdlePolicy {
+                spin_count_.load(std::memory_order_relaxed),
+                yield_count_.load(std::memory_order_relaxed),
+                max_spinners_.load(std::memory_order_relaxed)};
+        }
+
+        static constexpr size_t max_lifo_streak = 16;
+
+    private:
+        // bounded queues (ThreadSafeQueue with a capacity, BoundedMpmcQueue) - try_push() fails when full
+        static constexpr bool refuses_items = requires(TaskQueue& queue, QueuedTask&& item) { queue.try_push(std::move(item)); };
+
+        // touched only by the owning worker - padded against false sharing
+        struct alignas(64) LocalSlot
+        {
+            QueuedTask item;
+            size_t streak = 0;
+        };
+
+        detail::SharedStateSlab::OwnerPtr slab_ = detail::SharedStateSlab::create();
+        std::vector<std::thread> threads_;
+        TaskQueue tasks_;
+        std::atomic<bool> stopping_ {false};
+        std::atomic<size_t> running_workers_ {0};
+        std::once_flag workers_joined_;
+        std::atomic<bool> abandon_ {false};
+        std::atomic<int64_t> queued_stop_tasks_ {0};
+        std::atomic<bool> metrics_enabled_ {false};
+        PoolMetrics metrics_;
+        std::atomic<size_t> dropped_before_metrics_ {0};
+        std::atomic<bool> lifo_slot_enabled_ {false};
+        std::vector<LocalSlot> local_slots_;
+        PoolTracer tracer_;
+        std::atomic<size_t> spin_count_ {IdlePolicy::park().spin_count};
+        std::atomic<size_t> yield_count_ {IdlePolicy::park().yield_count};
+        std::atomic<size_t> max_spinners_ {IdlePolicy::park().max_spinners};
+        alignas(64) std::atomic<size_t> spinners_ {0};
+        std::once_flag timers_started_;
+        std::unique_ptr<TimerService> timers_;
+        detail::ParkedHelpers parked_helpers_;
+
+        TimerService& timers()
+        {
+            std::call_once(timers_started_, [this] { timers_ = std::make_unique<TimerService>(*this); });
+            return *timers_;
+        }
+
+        // into the LIFO slot of the calling worker if it is free
+        bool try_push_local(QueuedTask& item)
+        {
+            if (detail::current_worker.pool == this && lifo_slot_enabled())
+            {
+                LocalSlot& slot = local_slots_[detail::current_worker.index];
+                if (!slot.item.task)
+                {
+                    slot.item = std::move(item);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // like push() without the OverflowPolicy - for post_internal()
+        void push_internal(QueuedTask item)
+        {
+            if (try_push_local(item))
+                return;
+
+            if (stopping_.load(std::memory_order_relaxed))
+                push_while_stopping(std::move(item));
+            else
+                requeue(std::move(item));
+        }
+
+        // into the LIFO slot of the calling worker if it is free, otherwise into the shared queue
+        void push(QueuedTask item)
+        {
+            if (try_push_local(item))
+                return;
+
+            if (stopping_.load(std::memory_order_relaxed))
+            {
+                push_while_stopping(std::move(item));
+                return;
+            }
+
+            if constexpr (refuses_items)
+            {
+                if (runs_overflow_on_caller())
+                {
+                    if (tasks_.try_push(std::move(item)))
+                        parked_helpers_.wake_all();
+                    else
+                        run_on_caller(item);
+                    return;
+                }
+            }
+
+            tasks_.push(std::move(item));
+            parked_helpers_.wake_all();
+        }
+
+        // single queue operation unless a full queue makes the caller run some of the tasks
+        void push_range(std::vector<QueuedTask>& tasks)
+        {
+            if (stopping_.load(std::memory_order_relaxed))
+            {
+                for (auto& item : tasks)
+                    push_while_stopping(std::move(item));
+                return;
+            }
+
+            if constexpr (refuses_items)
+            {
+                if (runs_overflow_on_caller())
+                {
+                    auto first = tasks.begin();
+                    while (true)
+                    {
+                        first = tasks_.try_push_range(std::make_move_iterator(first), std::make_move_iterator(tasks.end())).base();
+                        parked_helpers_.wake_all();
+                        if (first == tasks.end())
+                            break;
+                        run_on_caller(*first++);
+                    }
+                    return;
+                }
+            }
+
+            tasks_.push_range(std::make_move_iterator(tasks.begin()), std::make_move_iterator(tasks.end()));
+            parked_helpers_.wake_all();
+        }
+
+        // workers may be gone - the capacity of a bounded queue is ignored (nobody may be left
+        // to make room) and a closed queue is emptied if the last worker already exited
+        void push_while_stopping(QueuedTask item)
+        {
+            requeue(std::move(item));
+
+            if constexpr (detail::closable_queue<TaskQueue>)
+            {
+                if (running_workers_.load() == 0)
+                    discard_backlog();
+            }
+        }
+
+        // called when no worker is left - destroyed tasks fulfill their futures with broken_promise
+        void discard_backlog()
+        {
+            QueuedTask item;
+            while (tasks_.pop(item))
+            {
+                if (item.enqueued_at != std::chrono::steady_clock::time_point {})
+                    metrics_.record_unqueued();
+                item = QueuedTask {};
+            }
+        }
+
+        // pushes regardless of the capacity of a bounded queue - for stop tasks, tasks
+        // moved back by workers and internal tasks, which must neither block nor fail
+        //  - a queue without force_push() cannot exceed its capacity: a worker finding it
+        //    full runs the task itself, or runs queued tasks until a stop task fits
+        void requeue(QueuedTask item)
+        {
+            if constexpr (requires { tasks_.force_push(std::move(item)); })
+                tasks_.force_push(std::move(item));
+            else if constexpr (refuses_items)
+            {
+                if (detail::current_worker.pool != this)
+                    tasks_.push(std::move(item));
+                else if (item.task)
+                {
+                    if (!tasks_.try_push(std::move(item)))
+                        run_on_caller(item);
+                }
+                else
+                    push_stop_task_from_worker(detail::current_worker.index);
+            }
+            else
+                tasks_.push(std::move(item));
+
+            parked_helpers_.wake_all();
+        }
+
+        // a stop task dequeued meanwhile is pushed back as well
+        void push_stop_task_from_worker(size_t index)
+        {
+            for (size_t stop_tasks = 1; stop_tasks > 0;)
+            {
+                if (tasks_.try_push(QueuedTask {}))
+                {
+                    --stop_tasks;
+                    continue;
+                }
+
+                QueuedTask item;
+                if (!tasks_.try_pop(item))
+                    std::this_thread::yield();
+                else if (item.task)
+                    execute(index, item, std::chrono::steady_clock::time_point {});
+                else
+                    ++stop_tasks;
+            }
+        }
+
+        // true if a task that does not fit into the full queue runs on the submitting thread
+        bool runs_overflow_on_caller() const
+        {
+            if constexpr (requires { tasks_.overflow_policy(); })
+            {
+                if (tasks_.capacity() == 0)
+                    return false;
+
+                const OverflowPolicy policy = tasks_.overflow_policy();
+                return policy == OverflowPolicy::caller_runs || (policy == OverflowPolicy::block && detail::current_worker.pool == this);
+            }
+            else
+                return detail::current_worker.pool == this; // push() waits for a consumer - a worker would wait for itself
+        }
+
+        void run_on_caller(QueuedTask& item)
+        {
+            if (item.enqueued_at != std::chrono::steady_clock::time_point {})
+                metrics_.record_unqueued();
+
+            if (is_discarded(item))
+            {
+                item.task = nullptr; // fulfills the future with broken_promise
+                return;
+            }
+
+            item.task();
+        }
+
+        // takes the task from the worker's LIFO slot - false if the slot is empty or was
+        // spilled to the shared queue after max_lifo_streak tasks in a row
+        bool try_pop_local(size_t index, QueuedTask& item)
+        {
+            LocalSlot& slot = local_slots_[index];
+
+            if (!slot.item.task)
+            {
+                slot.streak = 0;
+                return false;
+            }
+
+            // while stopping the stop tasks are queued already - a spilled task would not run
+            if (slot.streak >= max_lifo_streak && !stopping_.load(std::memory_order_relaxed))
+            {
+                slot.streak = 0;
+                requeue(std::move(slot.item));
+                slot.item = QueuedTask {};
+                return false;
+            }
+
+            ++slot.streak;
+            item = std::move(slot.item);
+            slot.item = QueuedTask {};
+            return true;
+        }
+
+        // the backlog is taken out of the queue at once if the queue allows it - otherwise
+        // workers discard queued tasks one by one until they reach the end of the queue
+        void abort_backlog()
+        {
+            abandon_.store(true, std::memory_order_relaxed);
+
+            if constexpr (requires { tasks_.take_all(); })
+            {
+                auto backlog = tasks_.take_all();
+                for (; !backlog.empty(); backlog.pop())
+                {
+                    if (backlog.front().enqueued_at != std::chrono::steady_clock::time_point {})
+                        metrics_.record_unqueued();
+                }
+            }
+
+            stop_workers();
+        }
+
+        // closes the queue or queues one stop task per worker - the first call wins
+        void stop_workers()
+        {
+            if (stopping_.exchange(true))
+                return;
+
+            if constexpr (detail::closable_queue<TaskQueue>)
+                tasks_.close();
+            else
+                for (size_t i = 0; i < threads_.size(); ++i)
+                    push_stop_task();
+        }
+
+        void push_stop_task()
+        {
+            requeue(QueuedTask {});
+
+            if constexpr (!detail::is_fifo_queue_v<TaskQueue>)
+                queued_stop_tasks_.fetch_add(1);
+        }
+
+        // true if the worker that dequeued a stop task should exit
+        bool accept_stop_task()
+        {
+            if constexpr (detail::is_fifo_queue_v<TaskQueue>)
+                return true;
+            else
+            {
+                // sub-queues are not FIFO with respect to each other - a stop task
+                // is re-queued as long as the queue holds anything but stop tasks
+                const int64_t queued_stop_tasks = queued_stop_tasks_.fetch_sub(1) - 1;
+                if (!abandon_.load(std::memory_order_relaxed) && static_cast<int64_t>(tasks_.size()) > queued_stop_tasks)
+                {
+                    push_stop_task();
+                    return false;
+                }
+                return true;
+            }
+        }
+
+        bool is_discarded(const QueuedTask& item) const
+        {
+            return abandon_.load(std::memory_order_relaxed) || item.stop_token.stop_requested();
+        }
+
+        template <typename F>
+        auto make_task(F&& f) -> std::pair<Task, Future<decltype(f())>>
+        {
+            return detail::package_task(slab_.get(), this, std::forward<F>(f));
+        }
+
+        QueuedTask make_queued(Task task, std::stop_token stop_token = {})
+        {
+            QueuedTask item {std::move(task), {}, std::move(stop_token)};
+
+            if constexpr (tracing_compiled_in)
+            {
+                if (tracer_.enabled())
+                    item.trace.stamp();
+            }
+
+            if (metrics_enabled())
+            {
+                metrics_.record_enqueued();
+                item.enqueued_at = std::chrono::steady_clock::now();
+            }
+
+            return item;
+        }
+
+        class WorkerWaitHelper : public detail::WaitHelper
+        {
+        public:
+            WorkerWaitHelper(BasicThreadPool& pool, size_t index)
+                : pool_ {pool}
+                , index_ {index}
+            {
+            }
+
+            bool run_pending_task() override
+            {
+                return pool_.try_run_pending_task(index_);
+            }
+
+            void park(detail::SharedStateBase& state) override
+            {
+                pool_.parked_helpers_.park(state, [this] { return !pool_.tasks_.empty(); });
+            }
+
+        private:
+            BasicThreadPool& pool_;
+            size_t index_;
+        };
+
+        // called by a worker waiting for a future
+        bool try_run_pending_task(size_t index)
+        {
+            QueuedTask item;
+            if (!try_pop_local(index, item) && !tasks_.try_pop(item))
+                return false;
+
+            // stop tasks are for the run loops - put it back
+            if (!item.task)
+            {
+                requeue(std::move(item));
+                return false;
+            }
+
+            execute(index, item, std::chrono::steady_clock::time_point {});
+            return true;
+        }
+
+        // polls the queue as the idle policy allows - false if the worker should park
+        bool try_pop_spinning(QueuedTask& item)
+        {
+            const size_t spin_count = spin_count_.load(std::memory_order_relaxed);
+            const size_t yield_count = yield_count_.load(std::memory_order_relaxed);
+            if (spin_count == 0 && yield_count == 0)
+                return false;
+
+            const size_t max_spinners = max_spinners_.load(std::memory_order_relaxed);
+            size_t spinners = spinners_.load(std::memory_order_relaxed);
+            do
+            {
+                if (spinners >= max_spinners)
+                    return false;
+            } while (!spinners_.compare_exchange_weak(spinners, spinners + 1, std::memory_order_relaxed));
+
+            bool has_item = false;
+
+            for (size_t i = 0; i < spin_count && !has_item; ++i)
+            {
+                has_item = tasks_.try_pop(item);
+                if (!has_item)
+                    detail::cpu_relax();
+            }
+
+            for (size_t i = 0; i < yield_count && !has_item; ++i)
+            {
+                has_item = tasks_.try_pop(item);
+                if (!has_item)
+                    std::this_thread::yield();
+            }
+
+            spinners_.fetch_sub(1, std::memory_order_relaxed);
+            return has_item;
+        }
+
+        // returns the time the task finished (or {} if metrics are disabled)
+        std::chrono::steady_clock::time_point execute(size_t index, QueuedTask& item, std::chrono::steady_clock::time_point idle_since)
+        {
+            if (is_discarded(item))
+            {
+                if (item.enqueued_at != std::chrono::steady_clock::time_point {})
+                    metrics_.record_discarded(index);
+                item.task = nullptr; // fulfills the future with broken_promise
+                return idle_since;
+            }
+
+            const bool traced = item.trace.stamped();
+
+            if (!metrics_enabled() && !traced)
+            {
+                item.task();
+                return {};
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            const auto idle_time = idle_since != std::chrono::steady_clock::time_point {} ? started - idle_since : std::chrono::steady_clock::duration::zero();
+            const bool has_queue_wait = item.enqueued_at != std::chrono::steady_clock::time_point {};
+            item.task();
+            const auto finished = std::chrono::steady_clock::now();
+
+            if constexpr (tracing_compiled_in)
+            {
+                if (traced)
+                    tracer_.record(index, item.trace.submitted(), started, finished);
+            }
+
+            if (!metrics_enabled())
+                return {};
+
+            metrics_.record_task(index, idle_time, started - item.enqueued_at, has_queue_wait, finished - started);
+            return finished;
+        }
+
+        void run(size_t index)
+        {
+            if constexpr (requires { tasks_.bind_worker(index); })
+                tasks_.bind_worker(index);
+
+            WorkerWaitHelper wait_helper {*this, index};
+            detail::current_wait_helper = &wait_helper;
+            detail::current_worker = detail::WorkerContext {this, index};
+
+            auto idle_since = std::chrono::steady_clock::now();
+
+            while (true)
+            {
+                // the slot is always drained before the shared queue is touched -
+                // it is empty when the worker finds the queue closed or dequeues its stop task
+                QueuedTask item;
+                if (!try_pop_local(index, item) && !try_pop_spinning(item))
+                {
+                    if constexpr (detail::closable_queue<TaskQueue>)
+                    {
+                        if (!tasks_.pop(item))
+                            break;
+                    }
+                    else
+                        tasks_.pop(item);
+                }
+
+                if (!item.task)
+                {
+                    if (accept_stop_task())
+                        break;
+                    continue;
+                }
+
+                idle_since = execute(index, item, idle_since);
+            }
+
+            detail::current_wait_helper = nullptr;
+            detail::current_worker = detail::WorkerContext {};
+
+            // tasks pushed by the last running tasks after the queue was found drained
+            if constexpr (detail::closable_queue<TaskQueue>)
+            {
+                if (running_workers_.fetch_sub(1) == 1)
+                    discard_backlog();
+            }
+        }
+    };
+
+    using ThreadPool = BasicThreadPool<ThreadSafeQueue<QueuedTask>>;
+    using LockFreeThreadPool = BasicThreadPool<BoundedMpmcQueue<QueuedTask>>;
+    using PriorityThreadPool = BasicThreadPool<PriorityTaskQueue<QueuedTask>>;
+    using NumaThreadPool = BasicThreadPool<NumaTaskQueue<QueuedTask>>;
+}
+
+#endif // THREAD_POOL_HPP
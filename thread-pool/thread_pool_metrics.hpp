@@ -0,0 +1,204 @@
+#ifndef THREAD_POOL_METRICS_HPP
+#define THREAD_POOL_METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ver_2_0
+{
+    //////////////////////////////////////////////////////////////////////
+    // histogram of durations with power-of-2 buckets:
+    // bucket i counts samples in [2^i, 2^(i+1)) ns (bucket 0 also holds 0ns)
+    struct LatencyHistogram
+    {
+        static constexpr size_t bucket_count = 40; // up to ~9 minutes
+
+        std::array<uint64_t, bucket_count> buckets {};
+
+        static size_t bucket_of(uint64_t ns)
+        {
+            size_t bucket = 0;
+            while (ns > 1 && bucket + 1 < bucket_count)
+            {
+                ns >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        uint64_t count() const
+        {
+            uint64_t total = 0;
+            for (auto n : buckets)
+                total += n;
+            return total;
+        }
+
+        // upper bound of the bucket holding the p-th percentile (p in [0, 1])
+        std::chrono::nanoseconds percentile(double p) const
+        {
+            const uint64_t total = count();
+            if (total == 0)
+                return std::chrono::nanoseconds::zero();
+
+            const auto rank = static_cast<uint64_t>(p * (total - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < bucket_count; ++i)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                    return std::chrono::nanoseconds(int64_t {2} << i);
+            }
+
+            return std::chrono::nanoseconds(int64_t {2} << (bucket_count - 1));
+        }
+
+        LatencyHistogram& operator+=(const LatencyHistogram& other)
+        {
+            for (size_t i = 0; i < bucket_count; ++i)
+                buckets[i] += other.buckets[i];
+            return *this;
+        }
+    };
+
+    struct WorkerMetrics
+    {
+        uint64_t tasks_executed;
+        std::chrono::nanoseconds busy_time;
+        std::chrono::nanoseconds idle_time;
+
+        double busy_ratio() const
+        {
+            const auto total = busy_time + idle_time;
+            return total.count() ? static_cast<double>(busy_time.count()) / total.count() : 0.0;
+        }
+    };
+
+    struct PoolMetricsSnapshot
+    {
+        std::vector<WorkerMetrics> workers;
+        LatencyHistogram queue_wait;
+        LatencyHistogram run_time;
+        size_t queue_depth;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // live counters of a thread pool
+    //  - every worker writes only its own cache-line aligned block, so
+    //    recording is a plain relaxed store - no contended read-modify-write
+    //  - snapshot() may be called from any thread at any time
+    class PoolMetrics
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit PoolMetrics(size_t worker_count)
+            : workers_ {std::make_unique<WorkerCounters[]>(worker_count)}
+            , worker_count_ {worker_count}
+        {
+        }
+
+        void record_enqueued(size_t count = 1)
+        {
+            enqueued_.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        // tasks counted by record_enqueued() that never reached a worker (run by the caller, dropped)
+        void record_unqueued(size_t count = 1)
+        {
+            enqueued_.fetch_sub(count, std::memory_order_relaxed);
+        }
+
+        // called only by worker index
+        void record_task(size_t index, Clock::duration idle, Clock::duration queue_wait, bool has_queue_wait, Clock::duration run_time)
+        {
+            WorkerCounters& w = workers_[index];
+
+            increment(w.tasks_executed);
+            add(w.idle_ns, to_ns(idle));
+            add(w.busy_ns, to_ns(run_time));
+            increment(w.run_time[LatencyHistogram::bucket_of(to_ns(run_time))]);
+
+            if (has_queue_wait)
+            {
+                increment(w.queue_wait[LatencyHistogram::bucket_of(to_ns(queue_wait))]);
+                increment(w.dequeued);
+            }
+        }
+
+        // called only by worker index - task left the queue without running
+        void record_discarded(size_t index)
+        {
+            increment(workers_[index].dequeued);
+        }
+
+        PoolMetricsSnapshot snapshot() const
+        {
+            PoolMetricsSnapshot result {};
+            result.workers.reserve(worker_count_);
+
+            uint64_t dequeued = 0;
+            for (size_t i = 0; i < worker_count_; ++i)
+            {
+                const WorkerCounters& w = workers_[i];
+
+                result.workers.push_back(WorkerMetrics {
+                    w.tasks_executed.load(std::memory_order_relaxed),
+                    std::chrono::nanoseconds(w.busy_ns.load(std::memory_order_relaxed)),
+                    std::chrono::nanoseconds(w.idle_ns.load(std::memory_order_relaxed))});
+
+                for (size_t b = 0; b < LatencyHistogram::bucket_count; ++b)
+                {
+                    result.queue_wait.buckets[b] += w.queue_wait[b].load(std::memory_order_relaxed);
+                    result.run_time.buckets[b] += w.run_time[b].load(std::memory_order_relaxed);
+                }
+
+                dequeued += w.dequeued.load(std::memory_order_relaxed);
+            }
+
+            const uint64_t enqueued = enqueued_.load(std::memory_order_relaxed);
+            result.queue_depth = enqueued > dequeued ? enqueued - dequeued : 0;
+
+            return result;
+        }
+
+    private:
+        struct alignas(64) WorkerCounters
+        {
+            std::atomic<uint64_t> tasks_executed {0};
+            std::atomic<uint64_t> dequeued {0};
+            std::atomic<uint64_t> busy_ns {0};
+            std::atomic<uint64_t> idle_ns {0};
+            std::array<std::atomic<uint64_t>, LatencyHistogram::bucket_count> queue_wait {};
+            std::array<std::atomic<uint64_t>, LatencyHistogram::bucket_count> run_time {};
+        };
+
+        std::unique_ptr<WorkerCounters[]> workers_;
+        const size_t worker_count_;
+        alignas(64) std::atomic<uint64_t> enqueued_ {0};
+
+        static uint64_t to_ns(Clock::duration d)
+        {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+            return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        }
+
+        // single writer - load & store instead of fetch_add
+        static void add(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static void increment(std::atomic<uint64_t>& counter)
+        {
+            add(counter, 1);
+        }
+    };
+}
+
+#endif // THREAD_POOL_METRICS_HPP
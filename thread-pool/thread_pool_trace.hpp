@@ -0,0 +1,210 @@
+#ifndef THREAD_POOL_TRACE_HPP
+#define THREAD_POOL_TRACE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// task tracing is compiled in only with THREAD_POOL_TRACING defined (cmake -DTHREAD_POOL_TRACING=ON) -
+// without it queued tasks carry no trace stamp and workers execute no tracing code
+//  - the macro must have the same value in every translation unit of a program
+
+namespace ver_2_0
+{
+#ifdef THREAD_POOL_TRACING
+    inline constexpr bool tracing_compiled_in = true;
+#else
+    inline constexpr bool tracing_compiled_in = false;
+#endif
+
+    // submit time carried by a queued task - an empty type when tracing is compiled out
+    class TraceStamp
+    {
+    public:
+        void stamp()
+        {
+            submitted_ = std::chrono::steady_clock::now();
+        }
+
+        bool stamped() const
+        {
+            return submitted_ != std::chrono::steady_clock::time_point {};
+        }
+
+        std::chrono::steady_clock::time_point submitted() const
+        {
+            return submitted_;
+        }
+
+    private:
+        std::chrono::steady_clock::time_point submitted_ {};
+    };
+
+    class NoTraceStamp
+    {
+    public:
+        void stamp()
+        {
+        }
+
+        constexpr bool stamped() const
+        {
+            return false;
+        }
+
+        std::chrono::steady_clock::time_point submitted() const
+        {
+            return {};
+        }
+    };
+
+    using TaskTraceStamp = std::conditional_t<tracing_compiled_in, TraceStamp, NoTraceStamp>;
+
+    //////////////////////////////////////////////////////////////////////
+    // per-worker task traces, exported as Chrome Trace Event JSON (chrome://tracing, ui.perfetto.dev)
+    //  - every worker appends to its own fixed-size buffer: a plain store of the event and a
+    //    release store of the size - no locks, no allocation while recording
+    //  - a full buffer stops recording and counts dropped events
+    //  - write_chrome_trace() may run while workers record - it sees the events published so far
+    class PoolTracer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit PoolTracer(size_t worker_count)
+            : worker_count_ {worker_count}
+        {
+        }
+
+        // the first call allocates the buffers; later calls only resume recording
+        void enable(size_t events_per_worker)
+        {
+            std::call_once(buffers_allocated_, [&] {
+                buffers_ = std::make_unique<WorkerBuffer[]>(worker_count_);
+                for (size_t i = 0; i < worker_count_; ++i)
+                    buffers_[i].events = std::make_unique<TraceEvent[]>(events_per_worker);
+                capacity_ = events_per_worker;
+            });
+
+            enabled_.store(true, std::memory_order_release);
+        }
+
+        void disable()
+        {
+            enabled_.store(false, std::memory_order_relaxed);
+        }
+
+        bool enabled() const
+        {
+            return enabled_.load(std::memory_order_acquire);
+        }
+
+        // called only by worker index, for tasks submitted while tracing was enabled
+        void record(size_t index, Clock::time_point submitted, Clock::time_point started, Clock::time_point finished)
+        {
+            WorkerBuffer& buffer = buffers_[index];
+
+            const size_t size = buffer.size.load(std::memory_order_relaxed);
+            if (size == capacity_)
+            {
+                buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return;
+            }
+
+            buffer.events[size] = TraceEvent {submitted, started, finished};
+            buffer.size.store(size + 1, std::memory_order_release);
+        }
+
+        size_t dropped_events() const
+        {
+            size_t dropped = 0;
+            if (buffers_)
+                for (size_t i = 0; i < worker_count_; ++i)
+                    dropped += buffers_[i].dropped.load(std::memory_order_relaxed);
+            return dropped;
+        }
+
+        // complete ("X") event per task on its worker's track (args: queue wait) and a
+        // "queued tasks" counter track rebuilt from the submit & start times
+        void write_chrome_trace(std::ostream& out, std::string_view process_name) const
+        {
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+            out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"" << process_name << "\"}}";
+
+            for (size_t i = 0; i < worker_count_; ++i)
+                out << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << i + 1 << ",\"args\":{\"name\":\"worker " << i << "\"}}";
+
+            std::vector<std::pair<Clock::time_point, int>> queue_changes;
+
+            if (buffers_)
+            {
+                for (size_t i = 0; i < worker_count_; ++i)
+                {
+                    const WorkerBuffer& buffer = buffers_[i];
+                    const size_t size = buffer.size.load(std::memory_order_acquire);
+
+                    for (size_t e = 0; e < size; ++e)
+                    {
+                        const TraceEvent& event = buffer.events[e];
+
+                        out << ",\n{\"ph\":\"X\",\"name\":\"task\",\"cat\":\"task\",\"pid\":1,\"tid\":" << i + 1
+                            << ",\"ts\":" << to_us(event.started) << ",\"dur\":" << to_us(event.finished) - to_us(event.started)
+                            << ",\"args\":{\"queue_wait_us\":" << to_us(event.started) - to_us(event.submitted) << "}}";
+
+                        queue_changes.emplace_back(event.submitted, 1);
+                        queue_changes.emplace_back(event.started, -1);
+                    }
+                }
+            }
+
+            std::sort(queue_changes.begin(), queue_changes.end());
+
+            int64_t queued = 0;
+            for (const auto& [time, change] : queue_changes)
+            {
+                queued += change;
+                out << ",\n{\"ph\":\"C\",\"name\":\"queued tasks\",\"pid\":1,\"tid\":0,\"ts\":" << to_us(time) << ",\"args\":{\"tasks\":" << queued << "}}";
+            }
+
+            out << "\n]}\n";
+        }
+
+    private:
+        struct TraceEvent
+        {
+            Clock::time_point submitted;
+            Clock::time_point started;
+            Clock::time_point finished;
+        };
+
+        struct alignas(64) WorkerBuffer
+        {
+            std::unique_ptr<TraceEvent[]> events;
+            std::atomic<size_t> size {0};
+            std::atomic<size_t> dropped {0};
+        };
+
+        const size_t worker_count_;
+        const Clock::time_point epoch_ = Clock::now();
+        std::once_flag buffers_allocated_;
+        std::unique_ptr<WorkerBuffer[]> buffers_;
+        size_t capacity_ = 0;
+        std::atomic<bool> enabled_ {false};
+
+        double to_us(Clock::time_point time) const
+        {
+            return std::chrono::duration<double, std::micro>(time - epoch_).count();
+        }
+    };
+}
+
+#endif // THREAD_POOL_TRACE_HPP
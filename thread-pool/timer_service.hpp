@@ -0,0 +1,216 @@
+#ifndef TIMER_SERVICE_HPP
+#define TIMER_SERVICE_HPP
+
+#include "executor.hpp"
+#include "timer_wheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ver_2_0
+{
+    //////////////////////////////////////////////////////////////////////
+    // one timer thread that hands due tasks over to an executor
+    //  - timers are kept in a TimerWheel guarded by a mutex: insert & cancel are O(1)
+    //  - the thread sleeps until the next event of the wheel (or until a timer
+    //    earlier than that is added) and never runs tasks itself
+    //  - a periodic task is skipped at ticks at which its previous run is still
+    //    in progress - runs of the same periodic task never overlap
+    //  - a run of a periodic task that throws (the exception goes to the executor like
+    //    from any posted task) or is dropped by the executor does not stop later ticks
+    //  - timers pending at destruction are dropped without running
+    class TimerService
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit TimerService(Executor& executor, std::chrono::milliseconds resolution = std::chrono::milliseconds {1})
+            : executor_ {executor}
+            , resolution_ {resolution}
+            , epoch_ {Clock::now()}
+        {
+            if (resolution_ <= Clock::duration::zero())
+                throw std::invalid_argument("Timer resolution must be positive");
+
+            thread_ = std::thread([this] { run(); });
+        }
+
+        TimerService(const TimerService&) = delete;
+        TimerService& operator=(const TimerService&) = delete;
+
+        ~TimerService()
+        {
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+                stop_ = true;
+            }
+            cv_.notify_one();
+            thread_.join();
+        }
+
+        TimerId post_at(Clock::time_point time, Task task)
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            return insert(ticks_until(time), TimerEntry {std::move(task), nullptr, 0});
+        }
+
+        TimerId post_after(Clock::duration delay, Task task)
+        {
+            return post_at(Clock::now() + delay, std::move(task));
+        }
+
+        // first run after one period
+        TimerId post_every(Clock::duration period, Task task)
+        {
+            if (!task)
+                throw std::invalid_argument("Empty task not supported");
+
+            const uint64_t period_ticks = std::max<uint64_t>(1, to_ticks(period));
+            auto periodic = std::make_shared<PeriodicTask>(std::move(task));
+
+            return insert(ticks_until(Clock::now() + period), TimerEntry {nullptr, std::move(periodic), period_ticks});
+        }
+
+        // false if the timer already fired (one-shot) or was cancelled;
+        // a run of a periodic task already handed over to the executor still runs
+        bool cancel(TimerId id)
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            return wheel_.cancel(id);
+        }
+
+        size_t pending() const
+        {
+            std::lock_guard<std::mutex> lk {mtx_};
+            return wheel_.size();
+        }
+
+    private:
+        struct PeriodicTask
+        {
+            explicit PeriodicTask(Task task)
+                : task {std::move(task)}
+            {
+            }
+
+            Task task;
+            std::atomic<bool> running {false};
+        };
+
+        struct TimerEntry
+        {
+            Task task;                              // one-shot
+            std::shared_ptr<PeriodicTask> periodic; // periodic
+            uint64_t period_ticks;
+        };
+
+        Executor& executor_;
+        const Clock::duration resolution_;
+        const Clock::time_point epoch_;
+
+        mutable std::mutex mtx_;
+        std::condition_variable cv_;
+        TimerWheel<TimerEntry> wheel_;
+        std::optional<uint64_t> wake_at_; // tick the timer thread sleeps until (nullopt - no timers)
+        bool stop_ = false;
+        std::thread thread_;
+
+        uint64_t to_ticks(Clock::duration d) const
+        {
+            // rounded up - a timer never fires early
+            return d <= Clock::duration::zero() ? 0 : static_cast<uint64_t>((d + resolution_ - Clock::duration {1}) / resolution_);
+        }
+
+        uint64_t ticks_until(Clock::time_point time) const
+        {
+            return to_ticks(time - epoch_);
+        }
+
+        uint64_t current_tick() const
+        {
+            return static_cast<uint64_t>((Clock::now() - epoch_) / resolution_);
+        }
+
+        TimerId insert(uint64_t expires, TimerEntry entry)
+        {
+            bool wake_up;
+            TimerId id;
+
+            {
+                std::lock_guard<std::mutex> lk {mtx_};
+                id = wheel_.insert(expires, std::move(entry));
+                wake_up = !wake_at_ || expires < *wake_at_;
+            }
+
+            if (wake_up)
+                cv_.notify_one();
+
+            return id;
+        }
+
+        void run()
+        {
+            std::vector<Task> due;
+            std::unique_lock<std::mutex> lk {mtx_};
+
+            while (!stop_)
+            {
+                wheel_.advance(current_tick(), [&](TimerId, TimerEntry& entry) -> std::optional<uint64_t>
+                    {
+                        if (!entry.periodic)
+                        {
+                            due.push_back(std::move(entry.task));
+                            return std::nullopt;
+                        }
+
+                        if (!entry.periodic->running.exchange(true))
+                        {
+                            due.push_back(detail::DroppableTask {
+                                [periodic = entry.periodic]
+                                {
+                                    struct RunningGuard
+                                    {
+                                        PeriodicTask& periodic;
+                                        ~RunningGuard() { periodic.running.store(false); }
+                                    } guard {*periodic};
+
+                                    periodic->task();
+                                },
+                                [periodic = entry.periodic] { periodic->running.store(false); }});
+                        }
+
+                        return wheel_.now() + entry.period_ticks;
+                    });
+
+                if (!due.empty())
+                {
+                    lk.unlock();
+                    for (auto& task : due)
+                        executor_.post_internal(std::move(task));
+                    due.clear();
+                    lk.lock();
+                    continue; // time went on while posting
+                }
+
+                wake_at_ = wheel_.next_event();
+                if (wake_at_)
+                    cv_.wait_until(lk, epoch_ + static_cast<Clock::rep>(*wake_at_) * resolution_);
+                else
+                    cv_.wait(lk);
+            }
+        }
+    };
+}
+
+#endif // TIMER_SERVICE_HPP
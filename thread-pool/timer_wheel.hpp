@@ -0,0 +1,286 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ver_2_0
+{
+    struct TimerId
+    {
+        uint32_t index = std::numeric_limits<uint32_t>::max();
+        uint32_t generation = 0;
+    };
+
+    //////////////////////////////////////////////////////////////////////
+    // hierarchical timer wheel (Varghese & Lauck) - not thread-safe
+    //  - time is measured in ticks; level l has 64 slots of 64^l ticks each,
+    //    5 levels cover 64^5 ticks (~12 days with 1ms ticks) - later timers
+    //    are parked in the last level and re-sorted when it cascades
+    //  - timers live in a pool of nodes linked by index into per-slot lists:
+    //    insert & cancel are O(1), TimerId = node index + generation
+    //  - a 64-bit occupancy mask per level lets advance() skip empty slots and
+    //    next_event() find the next tick worth waking up for
+    template <typename T>
+    class TimerWheel
+    {
+    public:
+        static constexpr size_t slot_bits = 6;
+        static constexpr size_t slots_per_level = size_t {1} << slot_bits;
+        static constexpr size_t level_count = 5;
+
+        explicit TimerWheel(uint64_t now = 0)
+            : current_ {now}
+        {
+            heads_.fill(npos);
+        }
+
+        uint64_t now() const
+        {
+            return current_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        // expires <= now() fires on the next advance()
+        TimerId insert(uint64_t expires, T payload)
+        {
+            const uint32_t index = allocate_node();
+            Node& node = nodes_[index];
+            node.expires = std::max(expires, current_ + 1);
+            node.payload.emplace(std::move(payload));
+
+            link(index);
+            ++size_;
+
+            return TimerId {index, node.generation};
+        }
+
+        // false if the timer already fired or was cancelled
+        bool cancel(TimerId id)
+        {
+            if (!contains(id))
+                return false;
+
+            unlink(id.index);
+            free_node(id.index);
+            --size_;
+
+            return true;
+        }
+
+        bool contains(TimerId id) const
+        {
+            return id.index < nodes_.size() && nodes_[id.index].generation == id.generation && nodes_[id.index].payload;
+        }
+
+        // moves time forward to now and calls on_expired(TimerId, T&) for every expired timer;
+        // on_expired returns the next expiry tick of a periodic timer (nullopt - the timer is done)
+        // and must not insert or cancel timers
+        template <typename F>
+        void advance(uint64_t now, F on_expired)
+        {
+            while (current_ < now)
+            {
+                if (size_ == 0)
+                {
+                    current_ = now;
+                    return;
+                }
+
+                // nothing due at level 0 before the next cascade - jump ahead
+                if (occupied_[0] == 0)
+                {
+                    const uint64_t next_cascade = (current_ | (slots_per_level - 1)) + 1;
+                    if (next_cascade > now)
+                    {
+                        current_ = now;
+                        return;
+                    }
+                    current_ = next_cascade - 1;
+                }
+
+                ++current_;
+                cascade();
+                expire_slot(on_expired);
+            }
+        }
+
+        // earliest tick at which advance() may fire a timer or cascade a slot
+        std::optional<uint64_t> next_event() const
+        {
+            if (size_ == 0)
+                return std::nullopt;
+
+            uint64_t result = std::numeric_limits<uint64_t>::max();
+
+            for (size_t level = 0; level < level_count; ++level)
+            {
+                if (occupied_[level] == 0)
+                    continue;
+
+                // first occupied slot after the current one
+                const size_t shift = level * slot_bits;
+                const uint64_t position = (current_ >> shift) + 1;
+                const uint64_t rotated = std::rotr(occupied_[level], static_cast<int>(position & (slots_per_level - 1)));
+                const uint64_t tick = (position + std::countr_zero(rotated)) << shift;
+
+                result = std::min(result, tick);
+            }
+
+            return result;
+        }
+
+    private:
+        static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+        struct Node
+        {
+            uint64_t expires = 0;
+            uint32_t prev = npos;
+            uint32_t next = npos;
+            uint32_t generation = 0;
+            uint32_t slot = 0;
+            std::optional<T> payload;
+        };
+
+        uint64_t current_;
+        size_t size_ = 0;
+        std::vector<Node> nodes_;
+        uint32_t free_list_ = npos;
+        std::array<uint32_t, level_count * slots_per_level> heads_;
+        std::array<uint64_t, level_count> occupied_ {};
+
+        uint32_t allocate_node()
+        {
+            if (free_list_ != npos)
+                return std::exchange(free_list_, nodes_[free_list_].next);
+
+            nodes_.emplace_back();
+            return static_cast<uint32_t>(nodes_.size() - 1);
+        }
+
+        void free_node(uint32_t index)
+        {
+            Node& node = nodes_[index];
+            node.payload.reset();
+            ++node.generation;
+            node.prev = npos;
+            node.next = std::exchange(free_list_, index);
+        }
+
+        uint32_t slot_of(uint64_t expires) const
+        {
+            const uint64_t delta = expires > current_ ? expires - current_ : 0;
+
+            for (size_t level = 0; level < level_count; ++level)
+            {
+                if (delta < (uint64_t {1} << ((level + 1) * slot_bits)))
+                    return static_cast<uint32_t>(level * slots_per_level + ((expires >> (level * slot_bits)) & (slots_per_level - 1)));
+            }
+
+            // beyond the wheel - park in the last level, expires is kept and re-sorted on cascade
+            constexpr size_t last = level_count - 1;
+            const uint64_t horizon = current_ + (uint64_t {1} << (level_count * slot_bits)) - 1;
+            return static_cast<uint32_t>(last * slots_per_level + ((horizon >> (last * slot_bits)) & (slots_per_level - 1)));
+        }
+
+        void link(uint32_t index)
+        {
+            Node& node = nodes_[index];
+            node.slot = slot_of(node.expires);
+            node.prev = npos;
+            node.next = heads_[node.slot];
+
+            if (node.next != npos)
+                nodes_[node.next].prev = index;
+            heads_[node.slot] = index;
+
+            occupied_[node.slot / slots_per_level] |= uint64_t {1} << (node.slot % slots_per_level);
+        }
+
+        void unlink(uint32_t index)
+        {
+            Node& node = nodes_[index];
+
+            if (node.prev != npos)
+                nodes_[node.prev].next = node.next;
+            else
+                heads_[node.slot] = node.next;
+
+            if (node.next != npos)
+                nodes_[node.next].prev = node.prev;
+
+            if (heads_[node.slot] == npos)
+                occupied_[node.slot / slots_per_level] &= ~(uint64_t {1} << (node.slot % slots_per_level));
+        }
+
+        uint32_t take_slot(uint32_t slot)
+        {
+            occupied_[slot / slots_per_level] &= ~(uint64_t {1} << (slot % slots_per_level));
+            return std::exchange(heads_[slot], npos);
+        }
+
+        // moves timers of higher-level slots that became current down the wheel
+        void cascade()
+        {
+            size_t top = 0;
+            while (top + 1 < level_count && (current_ & ((uint64_t {1} << ((top + 1) * slot_bits)) - 1)) == 0)
+                ++top;
+
+            for (size_t level = top; level > 0; --level)
+            {
+                const uint32_t slot = static_cast<uint32_t>(level * slots_per_level + ((current_ >> (level * slot_bits)) & (slots_per_level - 1)));
+
+                for (uint32_t index = take_slot(slot); index != npos;)
+                {
+                    const uint32_t next = nodes_[index].next;
+                    link(index);
+                    index = next;
+                }
+            }
+        }
+
+        template <typename F>
+        void expire_slot(F& on_expired)
+        {
+            const uint32_t slot = static_cast<uint32_t>(current_ & (slots_per_level - 1));
+
+            for (uint32_t index = take_slot(slot); index != npos;)
+            {
+                Node& node = nodes_[index];
+                const uint32_t next = node.next;
+
+                if (const std::optional<uint64_t> next_expiry = on_expired(TimerId {index, node.generation}, *node.payload))
+                {
+                    node.expires = std::max(*next_expiry, current_ + 1);
+                    link(index);
+                }
+                else
+                {
+                    free_node(index);
+                    --size_;
+                }
+
+                index = next;
+            }
+        }
+    };
+}
+
+#endif // TIMER_WHEEL_HPP
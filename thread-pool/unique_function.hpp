@@ -0,0 +1,195 @@
+#ifndef UNIQUE_FUNCTION_HPP
+#define UNIQUE_FUNCTION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ext
+{
+    template <typename Signature, size_t InlineSize = 56>
+    class unique_function;
+
+    //////////////////////////////////////////////////////////////////////
+    // move-only replacement of std::function
+    //  - callables that fit into InlineSize bytes (and are nothrow movable)
+    //    are stored in place - no heap allocation
+    //  - bigger callables are stored on the heap
+    template <typename R, typename... TArgs, size_t InlineSize>
+    class unique_function<R(TArgs...), InlineSize>
+    {
+        static_assert(InlineSize >= sizeof(void*), "InlineSize must be able to hold a pointer");
+
+        struct VTable
+        {
+            R (*invoke)(void* storage, TArgs&&... args);
+            void (*move)(void* dest, void* src) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename F>
+        static constexpr bool is_stored_inline_v = sizeof(F) <= InlineSize
+            && alignof(std::max_align_t) % alignof(F) == 0
+            && std::is_nothrow_move_constructible_v<F>;
+
+        template <typename F>
+        struct InlineStorage
+        {
+            static F* get(void* storage) noexcept
+            {
+                return std::launder(reinterpret_cast<F*>(storage));
+            }
+
+            static R invoke(void* storage, TArgs&&... args)
+            {
+                return std::invoke(*get(storage), std::forward<TArgs>(args)...);
+            }
+
+            static void move(void* dest, void* src) noexcept
+            {
+                ::new (dest) F(std::move(*get(src)));
+                get(src)->~F();
+            }
+
+            static void destroy(void* storage) noexcept
+            {
+                get(storage)->~F();
+            }
+
+            static constexpr VTable vtable {&invoke, &move, &destroy};
+        };
+
+        template <typename F>
+        struct HeapStorage
+        {
+            static F*& get(void* storage) noexcept
+            {
+                return *std::launder(reinterpret_cast<F**>(storage));
+            }
+
+            static R invoke(void* storage, TArgs&&... args)
+            {
+                return std::invoke(*get(storage), std::forward<TArgs>(args)...);
+            }
+
+            static void move(void* dest, void* src) noexcept
+            {
+                ::new (dest) F*(get(src));
+            }
+
+            static void destroy(void* storage) noexcept
+            {
+                delete get(storage);
+            }
+
+            static constexpr VTable vtable {&invoke, &move, &destroy};
+        };
+
+        alignas(std::max_align_t) unsigned char storage_[InlineSize];
+        const VTable* vtable_ = nullptr;
+
+        void reset() noexcept
+        {
+            if (vtable_)
+            {
+                vtable_->destroy(storage_);
+                vtable_ = nullptr;
+            }
+        }
+
+    public:
+        unique_function() noexcept = default;
+
+        unique_function(std::nullptr_t) noexcept
+        {
+        }
+
+        template <typename F, typename FT = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<FT, unique_function> && std::is_invocable_r_v<R, FT&, TArgs...>>>
+        unique_function(F&& f)
+        {
+            // a function reference decays to a pointer that is never null
+            if constexpr (std::is_pointer_v<std::remove_reference_t<F>> || std::is_member_pointer_v<std::remove_reference_t<F>>)
+            {
+                if (f == nullptr)
+                    return;
+            }
+
+            if constexpr (is_stored_inline_v<FT>)
+            {
+                ::new (static_cast<void*>(storage_)) FT(std::forward<F>(f));
+                vtable_ = &InlineStorage<FT>::vtable;
+            }
+            else
+            {
+                ::new (static_cast<void*>(storage_)) FT*(new FT(std::forward<F>(f)));
+                vtable_ = &HeapStorage<FT>::vtable;
+            }
+        }
+
+        unique_function(const unique_function&) = delete;
+        unique_function& operator=(const unique_function&) = delete;
+
+        unique_function(unique_function&& other) noexcept
+            : vtable_ {other.vtable_}
+        {
+            if (vtable_)
+            {
+                vtable_->move(storage_, other.storage_);
+                other.vtable_ = nullptr;
+            }
+        }
+
+        unique_function& operator=(unique_function&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+
+                if (other.vtable_)
+                {
+                    other.vtable_->move(storage_, other.storage_);
+                    vtable_ = std::exchange(other.vtable_, nullptr);
+                }
+            }
+
+            return *this;
+        }
+
+        unique_function& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        ~unique_function()
+        {
+            reset();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return vtable_ != nullptr;
+        }
+
+        R operator()(TArgs... args)
+        {
+            if (!vtable_)
+                throw std::bad_function_call();
+
+            return vtable_->invoke(storage_, std::forward<TArgs>(args)...);
+        }
+
+        // true if the callable is kept in the inline buffer
+        template <typename F>
+        static constexpr bool fits_inline()
+        {
+            return is_stored_inline_v<std::decay_t<F>>;
+        }
+    };
+}
+
+#endif // UNIQUE_FUNCTION_HPP
@@ -0,0 +1,184 @@
+#ifndef WORK_STEALING_THREAD_POOL_HPP
+#define WORK_STEALING_THREAD_POOL_HPP
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ver_3_0
+{
+    //////////////////////////////////////////////////////////////////////
+    // work-stealing scheduler
+    //  - every worker owns a deque: push & pop at the back (LIFO)
+    //  - idle workers steal from the front of a random victim's deque
+    //  - tasks submitted from outside of the pool are spread round-robin
+    class ThreadPool
+    {
+    public:
+        ThreadPool(size_t size)
+            : queues_(size)
+        {
+            for (auto& q : queues_)
+                q = std::make_unique<WorkerQueue>();
+
+            threads_.reserve(size);
+            for (size_t i = 0; i < size; ++i)
+                threads_.emplace_back([this, i]
+                    { run(i); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lk {mtx_idle_};
+                stop_ = true;
+            }
+            cv_idle_.notify_all();
+
+            for (auto& thread : threads_)
+                thread.join();
+        }
+
+        template <typename F>
+        auto submit(F&& f) -> std::future<decltype(f())>
+        {
+            using ResultT = decltype(f());
+            std::packaged_task<ResultT()> pt(std::forward<F>(f));
+            std::future<ResultT> f_result = pt.get_future();
+            push(Task {std::move(pt)});
+            return f_result;
+        }
+
+        size_t size() const
+        {
+            return threads_.size();
+        }
+
+    private:
+        struct alignas(64) WorkerQueue
+        {
+            std::mutex mtx;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+        std::vector<std::thread> threads_;
+        std::atomic<size_t> next_queue_ {0};
+
+        alignas(64) std::atomic<size_t> pending_ {0};
+        std::atomic<size_t> sleepers_ {0};
+        std::mutex mtx_idle_;
+        std::condition_variable cv_idle_;
+        bool stop_ = false;
+
+        static inline thread_local ThreadPool* current_pool_ = nullptr;
+        static inline thread_local size_t current_index_ = 0;
+
+        void push(Task task)
+        {
+            const size_t index = (current_pool_ == this)
+                ? current_index_
+                : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+            {
+                WorkerQueue& q = *queues_[index];
+                std::lock_guard<std::mutex> lk {q.mtx};
+                q.tasks.push_back(std::move(task));
+            }
+
+            pending_.fetch_add(1);
+
+            if (sleepers_.load() > 0)
+            {
+                { std::lock_guard<std::mutex> lk {mtx_idle_}; }
+                cv_idle_.notify_one();
+            }
+        }
+
+        bool pop_local(size_t index, Task& task)
+        {
+            WorkerQueue& q = *queues_[index];
+            std::lock_guard<std::mutex> lk {q.mtx};
+            if (q.tasks.empty())
+                return false;
+
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+
+        bool steal(size_t victim, Task& task)
+        {
+            WorkerQueue& q = *queues_[victim];
+            std::unique_lock<std::mutex> lk {q.mtx, std::try_to_lock};
+            if (!lk.owns_lock() || q.tasks.empty())
+                return false;
+
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+
+        bool try_steal(size_t index, std::minstd_rand& rnd, Task& task)
+        {
+            const size_t count = queues_.size();
+            const size_t start = rnd() % count;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t victim = (start + i) % count;
+                if (victim != index && steal(victim, task))
+                    return true;
+            }
+
+            return false;
+        }
+
+        void run(size_t index)
+        {
+            current_pool_ = this;
+            current_index_ = index;
+
+            std::minstd_rand rnd(static_cast<std::minstd_rand::result_type>(index + 1));
+
+            while (true)
+            {
+                Task task;
+                if (pop_local(index, task) || try_steal(index, rnd, task))
+                {
+                    pending_.fetch_sub(1);
+                    task();
+                    continue;
+                }
+
+                // tasks are pending but the victims were busy - try again
+                if (pending_.load() > 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lk {mtx_idle_};
+                sleepers_.fetch_add(1);
+                cv_idle_.wait(lk, [this] { return stop_ || pending_.load() > 0; });
+                sleepers_.fetch_sub(1);
+
+                if (stop_ && pending_.load() == 0)
+                    break;
+            }
+        }
+    };
+}
+
+#endif // WORK_STEALING_THREAD_POOL_HPP